@@ -0,0 +1,111 @@
+#ifndef _CHAIN_CHANNEL_H_
+#define _CHAIN_CHANNEL_H_
+
+#include <atomic>    // atomic
+#include <cstddef>   // size_t
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * A thread-safe channel that hands whole sc::list node chains from
+     * producers to a consumer without copying a single element.
+     *
+     * A producer fills a local list and calls send(), which detaches the whole
+     * chain and publishes it with one successful compare-and-swap. The consumer
+     * calls receive(), which takes every published chain with one exchange and
+     * splices them, in the order they were sent, at the end of its own list.
+     * Synchronisation cost is therefore paid per batch, not per element.
+     *
+     * \note
+     * Any number of threads may send. Only one thread at a time may receive.
+     */
+    template < typename T >
+    class chain_channel {
+        private:
+            using Node = typename list<T>::Node;
+
+            /// A published chain, waiting for the consumer.
+            struct batch {
+                Node * first;
+                Node * last;
+                size_t count;
+                batch * next; // Batch sent just before this one.
+            };
+
+            std::atomic< batch * > m_top; // Most recently sent batch.
+
+        public:
+            /**
+             * @brief Constructs an empty channel
+             */
+            chain_channel() : m_top{nullptr} {}
+
+            chain_channel( const chain_channel & ) = delete;
+            chain_channel & operator=( const chain_channel & ) = delete;
+
+            /**
+             * @brief Destroys the channel and every element still in flight
+             */
+            ~chain_channel() {
+                list<T> pending;
+                receive(pending);
+            }
+
+            /**
+             * @brief Moves every element of items into the channel. items becomes empty.
+             *
+             * @param items the batch to be sent
+             */
+            void send( list<T> & items ) {
+                if (items.empty())
+                    return;
+
+                auto b {new batch{items.m_head->next, items.m_tail->prev, items.m_len, nullptr}};
+                items.unlink_chain(b->first, b->last, b->count);
+
+                b->next = m_top.load(std::memory_order_relaxed);
+                while (not m_top.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed))
+                    ; // b->next was refreshed with the current top, try again.
+            }
+
+            /**
+             * @brief Moves every element sent so far to the end of into, in the order they were sent
+             *
+             * @param into the list that receives the elements
+             *
+             * @return how many elements were received
+             */
+            size_t receive( list<T> & into ) {
+                auto b {m_top.exchange(nullptr, std::memory_order_acquire)};
+
+                // The batches come newest first: reverse them so older batches are linked first.
+                batch * oldest {nullptr};
+                while (b != nullptr) {
+                    auto next {b->next};
+                    b->next = oldest;
+                    oldest = b;
+                    b = next;
+                }
+
+                size_t received {0};
+                while (oldest != nullptr) {
+                    into.link_chain(into.m_tail, oldest->first, oldest->last, oldest->count);
+                    received += oldest->count;
+
+                    auto target {oldest};
+                    oldest = oldest->next;
+                    delete target;
+                }
+                return received;
+            }
+
+            /**
+             * @return whether nothing is waiting in the channel
+             */
+            bool empty( void ) const {
+                return m_top.load(std::memory_order_acquire) == nullptr;
+            }
+    };
+}
+#endif
@@ -0,0 +1,14 @@
+#ifndef _SC_DETAIL_CACHE_LINE_H_
+#define _SC_DETAIL_CACHE_LINE_H_
+
+#include <cstddef>   // size_t
+
+namespace sc {
+    /// Size assumed for a cache line when padding data shared between threads.
+    /// Data written by different threads is kept apart with this many padding
+    /// bytes rather than with alignas: before C++17, operator new ignores
+    /// over-alignment, so an aligned member of a heap object may still share
+    /// a cache line with its neighbour.
+    constexpr std::size_t cache_line_size{ 64 };
+}
+#endif
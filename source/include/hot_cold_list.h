@@ -0,0 +1,268 @@
+#ifndef _HOT_COLD_LIST_H_
+#define _HOT_COLD_LIST_H_
+
+#include <cstddef>     // size_t, ptrdiff_t
+#include <functional>  // less
+#include <iterator>    // bidirectional_iterator_tag
+#include <stdexcept>   // out_of_range
+#include <type_traits> // decay
+#include <utility>     // declval
+
+#include "list.h"
+
+namespace sc {
+    /// The part of a hot_cold_list element that lives in the list node: the hot key and the payload address.
+    template < typename Key, typename T >
+    struct hot_link {
+        Key key;
+        T * payload;
+    };
+
+    /*!
+     * A list of large values split into hot and cold storage.
+     *
+     * Each sc::list node holds only a small hot key, computed from the value by
+     * KeyOf, and a pointer to the value, which lives out of line. Walking
+     * the list, sorting or merging by key, reversing and splicing therefore
+     * touch only the small link nodes; a payload is read only when an
+     * iterator is dereferenced.
+     *
+     * \note
+     * Values are only reachable as const, so the keys cannot go stale; use
+     * modify() to change a value, which also refreshes its key.
+     */
+    template < typename T, typename KeyOf >
+    class hot_cold_list {
+        public:
+            using key_type = typename std::decay< decltype(std::declval< KeyOf & >()(std::declval< const T & >())) >::type;
+            using link = hot_link< key_type, T >;
+
+            class const_iterator {
+                //=== Some aliases to help writing a clearer code.
+                public:
+                    using value_type        = T;
+                    using pointer           = const T *;
+                    using reference         = const T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                private:
+                    typename list< link >::const_iterator m_it; //!< The link node.
+
+                public:
+                    const_iterator( typename list< link >::const_iterator it = {} ) : m_it{it} {}
+
+                    /**
+                     * @return a const reference to the value; the only access that reads the cold storage
+                     */
+                    reference operator*() const {
+                        return *(*m_it).payload;
+                    }
+
+                    /**
+                     * @return the hot key of the value
+                     */
+                    const key_type & key( void ) const {
+                        return (*m_it).key;
+                    }
+
+                    const_iterator operator++() { ++m_it; return *this; }
+                    const_iterator operator++(int) { auto old {*this}; ++m_it; return old; }
+                    const_iterator operator--() { --m_it; return *this; }
+                    const_iterator operator--(int) { auto old {*this}; --m_it; return old; }
+
+                    bool operator==( const const_iterator & rhs ) const { return m_it == rhs.m_it; }
+                    bool operator!=( const const_iterator & rhs ) const { return m_it != rhs.m_it; }
+
+                    // We need friendship so the hot_cold_list class may access the m_it field.
+                    friend class hot_cold_list;
+            };
+
+        private:
+            list< link > m_links;
+            KeyOf m_key_of;
+
+            /**
+             * @return a mutable iterator to the link behind pos
+             */
+            typename list< link >::iterator link_of( const_iterator pos ) {
+                return typename list< link >::iterator{list< link >::node_of(pos.m_it)};
+            }
+
+            /**
+             * @return a link holding a copy of value out of line
+             */
+            link make_link( const T & value ) {
+                auto payload {new T(value)};
+                try {
+                    return link{m_key_of(*payload), payload};
+                } catch (...) {
+                    delete payload;
+                    throw;
+                }
+            }
+
+        public:
+            //=== [I] Special members
+            /**
+             * @brief Constructs an empty list
+             *
+             * @param key_of computes the hot key of a value
+             */
+            explicit hot_cold_list( KeyOf key_of = KeyOf{} ) : m_links{}, m_key_of{key_of} {}
+
+            hot_cold_list( const hot_cold_list & clone ) : m_links{}, m_key_of{clone.m_key_of} {
+                for (const auto & value : clone)
+                    push_back(value);
+            }
+
+            hot_cold_list & operator=( const hot_cold_list & rhs ) {
+                if (this != &rhs) {
+                    hot_cold_list copy {rhs};
+                    clear();
+                    m_links.splice(m_links.cbegin(), copy.m_links);
+                    m_key_of = rhs.m_key_of;
+                }
+                return *this;
+            }
+
+            ~hot_cold_list() {
+                clear();
+            }
+
+            //=== [II] ITERATORS
+            const_iterator begin() const { return const_iterator{m_links.cbegin()}; }
+            const_iterator end() const { return const_iterator{m_links.cend()}; }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            /**
+             * @return the link list, for scans that only need the hot keys
+             */
+            const list< link > & links( void ) const {
+                return m_links;
+            }
+
+            //=== [III] Capacity/Status
+            size_t size( void ) const { return m_links.size(); }
+            bool empty( void ) const { return m_links.empty(); }
+
+            /**
+             * @return the first value on the list
+             */
+            const T & front( void ) const {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return *begin();
+            }
+
+            /**
+             * @return the last value on the list
+             */
+            const T & back( void ) const {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return *std::prev(end());
+            }
+
+            //=== [IV] Modifiers
+            /**
+             * @brief Inserts a copy of value before pos
+             *
+             * @return a const_iterator to the new element
+             */
+            const_iterator insert( const_iterator pos, const T & value ) {
+                auto l {make_link(value)};
+                try {
+                    return const_iterator{m_links.insert(link_of(pos), l)};
+                } catch (...) {
+                    delete l.payload;
+                    throw;
+                }
+            }
+
+            void push_front( const T & value ) { insert(begin(), value); }
+            void push_back( const T & value ) { insert(end(), value); }
+
+            /**
+             * @brief Removes the value at pos
+             *
+             * @return a const_iterator to the element that followed it
+             */
+            const_iterator erase( const_iterator pos ) {
+                auto it {link_of(pos)};
+                delete (*it).payload;
+                return const_iterator{m_links.erase(it)};
+            }
+
+            /**
+             * @brief Erases every value of the list
+             */
+            void clear( void ) {
+                for (auto it {m_links.begin()}; it != m_links.end(); ++it)
+                    delete (*it).payload;
+                m_links.clear();
+            }
+
+            /**
+             * @brief Changes the value at pos in place with fn, then refreshes its hot key
+             *
+             * @param pos the element to change
+             * @param fn called with a reference to the value
+             */
+            template < typename Function >
+            void modify( const_iterator pos, Function fn ) {
+                auto it {link_of(pos)};
+                fn(*(*it).payload);
+                (*it).key = m_key_of(*(*it).payload);
+            }
+
+            //=== [V] UTILITY METHODS (link nodes only)
+            /**
+             * @brief Sorts the list by hot key. Stable; no payload is read.
+             */
+            void sort( void ) {
+                sort(std::less< key_type >{});
+            }
+
+            /**
+             * @brief Sorts the list by comp applied to the hot keys. Stable; no payload is read.
+             */
+            template < typename Compare >
+            void sort( Compare comp ) {
+                m_links.sort([&comp]( const link & a, const link & b ) { return comp(a.key, b.key); });
+            }
+
+            /**
+             * @brief Reverses the list. No payload is read.
+             */
+            void reverse( void ) {
+                m_links.reverse();
+            }
+
+            /**
+             * @brief Moves the values of other before pos, in O(1)
+             */
+            void splice( const_iterator pos, hot_cold_list & other ) {
+                m_links.splice(pos.m_it, other.m_links);
+            }
+
+            /**
+             * @brief Merges other, sorted by hot key, into this list, also sorted by hot key.
+             * other becomes empty. No payload is read.
+             */
+            void merge( hot_cold_list & other ) {
+                merge(other, std::less< key_type >{});
+            }
+
+            /**
+             * @brief Merges other into this list, both sorted by comp applied to the hot keys.
+             * other becomes empty. No payload is read.
+             */
+            template < typename Compare >
+            void merge( hot_cold_list & other, Compare comp ) {
+                m_links.merge(other.m_links, [&comp]( const link & a, const link & b ) { return comp(a.key, b.key); });
+            }
+    };
+}
+#endif
@@ -0,0 +1,458 @@
+#ifndef _INTRUSIVE_LIST_H_
+#define _INTRUSIVE_LIST_H_
+
+#include <cassert>     // assert()
+#include <cstddef>     // size_t, ptrdiff_t
+#include <functional>  // less, equal_to
+#include <iterator>    // bidirectional_iterator_tag
+#include <stdexcept>   // out_of_range
+#include <type_traits> // aligned_storage
+#include <utility>     // swap
+
+namespace sc {
+    /*!
+     * The links an object embeds to be put in an sc::intrusive_list.
+     *
+     * A hook unlinks itself when it is destroyed, so an object may die while
+     * it is still in a list. Copying an object does not copy its links: the
+     * copy starts out unlinked.
+     */
+    struct list_hook {
+        list_hook * next;
+        list_hook * prev;
+
+        list_hook() : next{nullptr}, prev{nullptr} {}
+        list_hook( const list_hook & ) : list_hook() {}
+        list_hook & operator=( const list_hook & ) { return *this; }
+
+        ~list_hook() {
+            unlink();
+        }
+
+        /**
+         * @return whether the hook is in a list
+         */
+        bool is_linked( void ) const {
+            return next != nullptr;
+        }
+
+        /**
+         * @brief Takes the hook out of its list, if it is in one
+         */
+        void unlink( void ) {
+            if (not is_linked())
+                return;
+            prev->next = next;
+            next->prev = prev;
+            next = prev = nullptr;
+        }
+    };
+
+    /*!
+     * A doubly linked list of objects that carry their own links, in the
+     * list_hook member Hook.
+     *
+     * The list never allocates and never copies: it links the objects it is
+     * given, which must outlive their stay in the list (or unlink themselves
+     * by dying). An object can be in one list per hook it has.
+     *
+     * \note
+     * Since hooks may unlink themselves behind the list's back, the list does
+     * not keep a count: size() walks the list.
+     */
+    template < typename T, list_hook T::*Hook >
+    class intrusive_list {
+        private:
+            list_hook m_root; //!< Sentinel: the list is a ring through it.
+
+            /**
+             * @return how far the hook lies from the start of a T
+             */
+            static std::ptrdiff_t hook_offset( void ) {
+                // Only the address of the member is taken; the storage is never read.
+                typename std::aligned_storage< sizeof(T), alignof(T) >::type probe;
+                auto object {reinterpret_cast< T * >(&probe)};
+                return reinterpret_cast< char * >(&(object->*Hook)) - reinterpret_cast< char * >(object);
+            }
+
+            /**
+             * @return the object hook is embedded in
+             */
+            static T * owner( list_hook * hook ) {
+                return reinterpret_cast< T * >(reinterpret_cast< char * >(hook) - hook_offset());
+            }
+
+            static void link_before( list_hook * pos, list_hook * hook ) {
+                hook->prev      = pos->prev;
+                hook->next      = pos;
+                pos->prev->next = hook;
+                pos->prev       = hook;
+            }
+
+            /**
+             * @brief Merges two sorted chains linked through next and ended by nullptr. Stable.
+             */
+            template < typename Compare >
+            static list_hook * merge_chains( list_hook * a, list_hook * b, Compare & comp ) {
+                list_hook * first {nullptr};
+                list_hook ** tail {&first};
+                while (a != nullptr and b != nullptr) {
+                    if (comp(*owner(b), *owner(a))) {
+                        *tail = b;
+                        b = b->next;
+                    } else {
+                        *tail = a;
+                        a = a->next;
+                    }
+                    tail = &(*tail)->next;
+                }
+                *tail = a != nullptr ? a : b;
+                return first;
+            }
+
+            /**
+             * @brief Sorts the n hooks starting at first, following next. Stable.
+             *
+             * @return the sorted chain, linked through next and ended by nullptr
+             */
+            template < typename Compare >
+            static list_hook * sort_chain( list_hook * first, size_t n, Compare & comp ) {
+                if (n == 1) {
+                    first->next = nullptr;
+                    return first;
+                }
+                auto mid {first};
+                for (size_t i {0}; i < n / 2; i++)
+                    mid = mid->next;
+                auto left {sort_chain(first, n / 2, comp)};
+                auto right {sort_chain(mid, n - n / 2, comp)};
+                return merge_chains(left, right, comp);
+            }
+
+        public:
+            class const_iterator;
+
+            class iterator {
+                public:
+                    using value_type        = T;
+                    using pointer           = T *;
+                    using reference         = T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                private:
+                    list_hook * m_hook;
+
+                public:
+                    iterator( list_hook * hook = nullptr ) : m_hook{hook} {}
+
+                    reference operator*() const { return *owner(m_hook); }
+                    pointer operator->() const { return owner(m_hook); }
+
+                    iterator operator++() { m_hook = m_hook->next; return *this; }
+                    iterator operator++(int) { auto old {*this}; m_hook = m_hook->next; return old; }
+                    iterator operator--() { m_hook = m_hook->prev; return *this; }
+                    iterator operator--(int) { auto old {*this}; m_hook = m_hook->prev; return old; }
+
+                    bool operator==( const iterator & rhs ) const { return m_hook == rhs.m_hook; }
+                    bool operator!=( const iterator & rhs ) const { return m_hook != rhs.m_hook; }
+
+                    friend class intrusive_list;
+                    friend class const_iterator;
+            };
+
+            class const_iterator {
+                public:
+                    using value_type        = T;
+                    using pointer           = const T *;
+                    using reference         = const T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                private:
+                    list_hook * m_hook;
+
+                public:
+                    const_iterator( list_hook * hook = nullptr ) : m_hook{hook} {}
+                    const_iterator( const iterator & it ) : m_hook{it.m_hook} {}
+
+                    reference operator*() const { return *owner(m_hook); }
+                    pointer operator->() const { return owner(m_hook); }
+
+                    const_iterator operator++() { m_hook = m_hook->next; return *this; }
+                    const_iterator operator++(int) { auto old {*this}; m_hook = m_hook->next; return old; }
+                    const_iterator operator--() { m_hook = m_hook->prev; return *this; }
+                    const_iterator operator--(int) { auto old {*this}; m_hook = m_hook->prev; return old; }
+
+                    bool operator==( const const_iterator & rhs ) const { return m_hook == rhs.m_hook; }
+                    bool operator!=( const const_iterator & rhs ) const { return m_hook != rhs.m_hook; }
+
+                    friend class intrusive_list;
+            };
+
+            //=== [I] Special members
+            intrusive_list() {
+                m_root.next = m_root.prev = &m_root;
+            }
+
+            intrusive_list( const intrusive_list & ) = delete;
+            intrusive_list & operator=( const intrusive_list & ) = delete;
+
+            /**
+             * @brief Takes over the objects linked in other, which becomes empty
+             */
+            intrusive_list( intrusive_list && other ) : intrusive_list() {
+                splice(cend(), other);
+            }
+
+            intrusive_list & operator=( intrusive_list && rhs ) {
+                if (this != &rhs) {
+                    clear();
+                    splice(cend(), rhs);
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Unlinks every object; none is destroyed
+             */
+            ~intrusive_list() {
+                clear();
+            }
+
+            //=== [II] ITERATORS
+            iterator begin() { return iterator{m_root.next}; }
+            iterator end() { return iterator{&m_root}; }
+            const_iterator begin() const { return const_iterator{m_root.next}; }
+            const_iterator end() const { return const_iterator{const_cast< list_hook * >(&m_root)}; }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            /**
+             * @return an iterator to object, which must be in this list. O(1).
+             */
+            static iterator iterator_to( T & object ) {
+                return iterator{&(object.*Hook)};
+            }
+
+            /**
+             * @return a const_iterator to object, which must be in this list. O(1).
+             */
+            static const_iterator iterator_to( const T & object ) {
+                return const_iterator{const_cast< list_hook * >(&(object.*Hook))};
+            }
+
+            //=== [III] Capacity/Status
+            bool empty( void ) const { return m_root.next == &m_root; }
+
+            /**
+             * @return how many objects are linked. Walks the list.
+             */
+            size_t size( void ) const {
+                size_t count {0};
+                for (auto hook {m_root.next}; hook != &m_root; hook = hook->next)
+                    count++;
+                return count;
+            }
+
+            T & front( void ) {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return *owner(m_root.next);
+            }
+
+            T & back( void ) {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return *owner(m_root.prev);
+            }
+
+            //=== [IV] Modifiers
+            /**
+             * @brief Links object before pos. object must not be in a list through this hook.
+             *
+             * @return an iterator to object
+             */
+            iterator insert( const_iterator pos, T & object ) {
+                auto hook {&(object.*Hook)};
+                assert(not hook->is_linked());
+                link_before(pos.m_hook, hook);
+                return iterator{hook};
+            }
+
+            void push_front( T & object ) { insert(cbegin(), object); }
+            void push_back( T & object ) { insert(cend(), object); }
+
+            /**
+             * @brief Unlinks the object at pos; it is not destroyed
+             *
+             * @return an iterator to the object that followed it
+             */
+            iterator erase( const_iterator pos ) {
+                auto next {pos.m_hook->next};
+                pos.m_hook->unlink();
+                return iterator{next};
+            }
+
+            void pop_front() {
+                if (empty())
+                    throw std::out_of_range("pop_front(): cannot use the front method on an empty list.");
+                erase(cbegin());
+            }
+
+            void pop_back() {
+                if (empty())
+                    throw std::out_of_range("pop_back(): cannot use the back method on an empty list.");
+                erase(const_iterator{m_root.prev});
+            }
+
+            /**
+             * @brief Unlinks every object; none is destroyed
+             */
+            void clear( void ) {
+                auto hook {m_root.next};
+                while (hook != &m_root) {
+                    auto next {hook->next};
+                    hook->next = hook->prev = nullptr;
+                    hook = next;
+                }
+                m_root.next = m_root.prev = &m_root;
+            }
+
+            //=== [V] UTILITY METHODS
+            /**
+             * @brief Moves the objects of other before pos, in O(1). other becomes empty.
+             */
+            void splice( const_iterator pos, intrusive_list & other ) {
+                if (&other == this or other.empty())
+                    return;
+                splice(pos, other, other.cbegin(), other.cend());
+            }
+
+            /**
+             * @brief Moves the object at it, in other, before pos
+             */
+            void splice( const_iterator pos, intrusive_list & other, const_iterator it ) {
+                (void)other;
+                if (it == pos)
+                    return;
+                it.m_hook->unlink();
+                link_before(pos.m_hook, it.m_hook);
+            }
+
+            /**
+             * @brief Moves the objects of [first, last), in other, before pos, in O(1)
+             */
+            void splice( const_iterator pos, intrusive_list & other, const_iterator first, const_iterator last ) {
+                (void)other;
+                if (first == last)
+                    return;
+                auto head {first.m_hook};
+                auto tail {last.m_hook->prev};
+
+                head->prev->next = last.m_hook;
+                last.m_hook->prev = head->prev;
+
+                head->prev = pos.m_hook->prev;
+                head->prev->next = head;
+                tail->next = pos.m_hook;
+                pos.m_hook->prev = tail;
+            }
+
+            /**
+             * @brief Merges the sorted list other into this sorted list. other becomes empty.
+             */
+            void merge( intrusive_list & other ) {
+                merge(other, std::less< T >{});
+            }
+
+            /**
+             * @brief Merges other into this list, both sorted by comp. other becomes empty.
+             * Equal objects of this list go first.
+             */
+            template < typename Compare >
+            void merge( intrusive_list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+                auto curr {m_root.next};
+                while (not other.empty()) {
+                    auto first {other.m_root.next};
+                    while (curr != &m_root and not comp(*owner(first), *owner(curr)))
+                        curr = curr->next;
+                    first->unlink();
+                    link_before(curr, first);
+                }
+            }
+
+            /**
+             * @brief Sorts the list with a stable merge sort, relinking the objects
+             */
+            void sort( void ) {
+                sort(std::less< T >{});
+            }
+
+            /**
+             * @brief Sorts the list by comp with a stable merge sort, relinking the objects
+             */
+            template < typename Compare >
+            void sort( Compare comp ) {
+                auto n {size()};
+                if (n < 2)
+                    return;
+                auto first {sort_chain(m_root.next, n, comp)};
+
+                // Rebuild the prev links of the sorted chain.
+                auto prev {&m_root};
+                for (auto hook {first}; hook != nullptr; hook = hook->next) {
+                    hook->prev = prev;
+                    prev->next = hook;
+                    prev = hook;
+                }
+                prev->next = &m_root;
+                m_root.prev = prev;
+            }
+
+            /**
+             * @brief Reverses the list, relinking the objects
+             */
+            void reverse( void ) {
+                auto hook {&m_root};
+                do {
+                    std::swap(hook->next, hook->prev);
+                    hook = hook->prev;
+                } while (hook != &m_root);
+            }
+
+            /**
+             * @brief Unlinks every object equal to the one before it
+             *
+             * @return how many objects were unlinked
+             */
+            size_t unique( void ) {
+                return unique(std::equal_to< T >{});
+            }
+
+            /**
+             * @brief Unlinks every object for which pred holds with the one kept before it
+             *
+             * @return how many objects were unlinked
+             */
+            template < typename BinaryPredicate >
+            size_t unique( BinaryPredicate pred ) {
+                size_t removed {0};
+                if (empty())
+                    return removed;
+                auto kept {m_root.next};
+                while (kept->next != &m_root) {
+                    auto next {kept->next};
+                    if (pred(*owner(kept), *owner(next))) {
+                        next->unlink();
+                        removed++;
+                    } else
+                        kept = next;
+                }
+                return removed;
+            }
+    };
+}
+#endif
@@ -11,8 +11,193 @@ using std::endl;
 using std::copy;
 #include <cstddef>   // std::ptrdiff_t
 #include <type_traits>
+#include <functional> // less
+#include <vector>     // vector
+#include <utility>    // pair, declval, move, move_if_noexcept
+#include <atomic>     // atomic
+#include <new>        // operator new, nothrow, align_val_t
+#include <stdexcept>  // length_error, out_of_range
+#include <cstring>    // memcpy
+
+/// Asks the cache for the line holding addr, without waiting for it. A no-op where unsupported.
+#if defined(__GNUC__) || defined(__clang__)
+#   define SC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#   define SC_PREFETCH(addr) ((void)(addr))
+#endif
 
 namespace sc { // linear sequence. Better name: sequence container (same as STL).
+    template < typename T > class list;
+
+    /// How many nodes the look-ahead pointer of a prefetching traversal runs ahead of the current one.
+    constexpr size_t prefetch_distance{ 4 };
+
+    /**
+     * @brief Allocates raw memory for objects aligned to Align, the way a new-expression
+     * would: the aligned operator new is only used when Align is beyond the default.
+     *
+     * @param bytes the size of the memory
+     *
+     * @return the memory; memory from here must go back through raw_deallocate<Align>()
+     */
+    template < size_t Align >
+    void * raw_allocate( size_t bytes ) {
+        if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t{Align});
+        else
+            return ::operator new(bytes);
+    }
+
+    /**
+     * @brief Like raw_allocate(), but gives back nullptr instead of throwing std::bad_alloc
+     */
+    template < size_t Align >
+    void * raw_allocate( size_t bytes, const std::nothrow_t & tag ) noexcept {
+        if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t{Align}, tag);
+        else
+            return ::operator new(bytes, tag);
+    }
+
+    /**
+     * @brief Frees memory obtained from raw_allocate<Align>()
+     */
+    template < size_t Align >
+    void raw_deallocate( void * storage ) noexcept {
+        if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(storage, std::align_val_t{Align});
+        else
+            ::operator delete(storage);
+    }
+
+    /*!
+     * A per-thread cache of free node memory of Size bytes aligned to Align,
+     * shared by every list of that thread whose nodes have that size and
+     * alignment.
+     *
+     * Lists give the memory of the nodes they destroy to the cache of the
+     * calling thread and take from it before calling operator new. The cache
+     * is off (its limit is 0) until a thread sets a limit, and it never holds
+     * more than that limit; trim() gives memory back to the heap.
+     *
+     * Each thread only touches its own cache, so no locking is needed: a node
+     * allocated on one thread and destroyed on another simply lands in the
+     * cache of the second thread. The memory always comes from
+     * raw_allocate<Align>(), so it can be freed from any thread.
+     */
+    template < size_t Size, size_t Align >
+    class node_cache {
+        private:
+            struct free_block {
+                free_block * next;
+            };
+
+            // Trivially destructible, so it stays usable while other thread_local objects are destroyed.
+            struct state {
+                free_block * first;
+                size_t count;
+                size_t limit;
+            };
+
+            /// Empties the cache when its thread ends, and turns it off for what runs after.
+            struct reaper {
+                ~reaper() {
+                    node_cache::set_limit(0);
+                }
+            };
+
+            static state & local( void ) {
+                static thread_local state s {nullptr, 0, 0};
+                static thread_local reaper r;
+                (void)r;
+                return s;
+            }
+
+        public:
+            /**
+             * @brief Sets how many blocks the cache of the calling thread may hold, trimming it if needed.
+             * A limit of 0 turns the cache off.
+             */
+            static void set_limit( size_t n ) {
+                local().limit = n;
+                trim(n);
+            }
+
+            /**
+             * @return the limit of the cache of the calling thread
+             */
+            static size_t limit( void ) {
+                return local().limit;
+            }
+
+            /**
+             * @return how many blocks the cache of the calling thread holds
+             */
+            static size_t size( void ) {
+                return local().count;
+            }
+
+            /**
+             * @brief Gives blocks back to the heap until the cache of the calling thread holds at most keep
+             */
+            static void trim( size_t keep = 0 ) {
+                auto & s {local()};
+                while (s.count > keep) {
+                    auto block {s.first};
+                    s.first = block->next;
+                    s.count--;
+                    raw_deallocate< Align >(block);
+                }
+            }
+
+            /**
+             * @return a cached block, or nullptr if the cache of the calling thread is empty
+             */
+            static void * take( void ) {
+                auto & s {local()};
+                auto block {s.first};
+                if (block != nullptr) {
+                    s.first = block->next;
+                    s.count--;
+                }
+                return block;
+            }
+
+            /**
+             * @brief Keeps storage, a block of Size bytes from raw_allocate<Align>(), in the cache
+             * of the calling thread, or frees it if the cache is full
+             */
+            static void release( void * storage ) {
+                auto & s {local()};
+                if (s.count >= s.limit) {
+                    raw_deallocate< Align >(storage);
+                    return;
+                }
+                s.first = new (storage) free_block{s.first};
+                s.count++;
+            }
+    };
+
+    template < typename T, typename Function >
+    void for_each_prefetch( list<T> & l, Function fn, size_t distance = prefetch_distance );
+
+    template < typename T, typename Function >
+    void for_each_prefetch( const list<T> & l, Function fn, size_t distance = prefetch_distance );
+
+    namespace par {
+        // Parallel algorithms that relink list nodes directly (see par.h).
+        template < typename T >
+        void merge( list<T> & l, list<T> & other, size_t n_workers = 0 );
+
+        // Not a candidate when the third argument is a number of workers.
+        template < typename T, typename Compare,
+                   typename = typename std::enable_if< not std::is_integral< Compare >::value >::type >
+        void merge( list<T> & l, list<T> & other, Compare comp, size_t n_workers = 0 );
+    }
+
+    template < typename T, typename Compare >
+    list<T> merge_all( std::vector< list<T> > & shards, Compare comp );
+
     /*!
      * A class representing a biderectional iterator defined over a linked list.
      *
@@ -28,15 +213,53 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
     template < typename T >
     class list {
         private:
+            struct node_block;
+
+            /// Selects the Node constructor that builds the value in place from its arguments.
+            struct emplace_tag {};
+
             //=== the data node.
             struct Node {
                 T data; // Tipo de informação a ser armazenada no container.
                 Node * next;
                 Node * prev;
+                // Block the node was placed in by compact(), or nullptr if allocated alone. Nodes move
+                // between lists (splice, merge) and threads, so whoever destroys one must tell from
+                // the node alone how its memory goes back.
+                node_block * block;
 
                 Node( const T &d=T{} , Node * n=nullptr, Node * p=nullptr )
-                    : data {d}, next{n}, prev{p}
+                    : data {d}, next{n}, prev{p}, block{nullptr}
+                { /* empty */ }
+
+                Node( T &&d, Node * n=nullptr, Node * p=nullptr )
+                    : data {std::move(d)}, next{n}, prev{p}, block{nullptr}
+                { /* empty */ }
+
+                template < typename... Args >
+                Node( emplace_tag, Args &&... args )
+                    : data(std::forward<Args>(args)...), next{nullptr}, prev{nullptr}, block{nullptr}
+                { /* empty */ }
+            };
+
+            /// The storage of a free node while it waits in the spare pool.
+            struct spare_node {
+                spare_node * next;
+            };
+
+            /// Contiguous storage for nodes, filled by compact(). Freed when its last node is destroyed.
+            struct node_block {
+                Node * slots;              // Raw storage for capacity nodes.
+                size_t capacity;
+                std::atomic< size_t > live; // Nodes constructed in the block and not destroyed yet.
+
+                explicit node_block( size_t n )
+                    : slots{static_cast< Node * >(raw_allocate< alignof(Node) >(n * sizeof(Node)))}, capacity{n}, live{0}
                 { /* empty */ }
+
+                ~node_block() {
+                    raw_deallocate< alignof(Node) >(slots);
+                }
             };
 
 
@@ -46,8 +269,8 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 //=== Some aliases to help writing a clearer code.
                 public:
                     using value_type        = T;         //!< The type of the value stored in the list.
-                    using pointer           = T *;       //!< Pointer to the value.
-                    using reference         = T &;       //!< reference to the value.
+                    using pointer           = const T *; //!< Pointer to the value, which cannot be changed through it.
+                    using reference         = const T &; //!< reference to the value, which cannot be changed through it.
                     using const_reference   = const T &; //!< const reference to the value.
                     using difference_type   = std::ptrdiff_t;
                     using iterator_category = std::bidirectional_iterator_tag;
@@ -310,6 +533,11 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                     /// it1 - it2
                     difference_type operator-( const iterator & rhs ) const { /* TODO */ return 0; }
 
+                    /// Any iterator can be used where a const_iterator is expected (e.g., splice).
+                    operator const_iterator() const {
+                        return const_iterator{m_ptr};
+                    }
+
                     // We need friendship so the list<T> class may access the m_ptr field.
                     friend class list<T>;
 
@@ -322,10 +550,391 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
 
         //=== Private members.
         private:
+            /// Consecutive wins of one side after which merge() starts galloping.
+            static constexpr size_t min_gallop{ 7 };
+
+            /// T is copied by memcpy and has no destructor to run, so values can be handled as raw bytes.
+            static constexpr bool trivial_value{ std::is_trivially_copyable<T>::value and std::is_trivially_destructible<T>::value };
+
             size_t m_len;  // comprimento da lista.
             Node * m_head; // nó cabeça.
             Node * m_tail; // nó calda.
 
+            spare_node * m_spare {nullptr}; // Nós livres guardados por reserve().
+            size_t m_spare_count {0};
+            size_t m_reserved {0};          // Capacidade pedida a reserve().
+            bool m_no_alloc {false};        // Quando true, só nós do pool são usados.
+
+            // Containers built on top of list move whole node chains in and out of it.
+            template < typename U > friend class chain_channel;
+            template < typename U > friend class ws_deque;
+            template < typename U, typename Compare > friend class sorted_list;
+            template < typename U, typename KeyOf > friend class hot_cold_list;
+            template < typename U, size_t M > friend class small_list;
+            template < typename U, typename Compare, typename Enable >
+            friend void par::merge( list<U> &, list<U> &, Compare, size_t );
+            template < typename U, typename Compare >
+            friend list<U> merge_all( std::vector< list<U> > &, Compare );
+            template < typename U, typename Function >
+            friend void for_each_prefetch( list<U> &, Function, size_t );
+            template < typename U, typename Function >
+            friend void for_each_prefetch( const list<U> &, Function, size_t );
+            template < typename U >
+            friend bool operator==( const list<U> &, const list<U> & );
+
+            //=== Raw chain helpers.
+            /**
+             * @return the node pos points to
+             */
+            static Node * node_of( const_iterator pos ) {
+                return pos.m_ptr;
+            }
+
+            /**
+             * @brief Detaches the nodes [first, last] from the list. They stay linked to each other.
+             *
+             * @param first the first node of the chain
+             * @param last the last node of the chain
+             * @param count how many nodes the chain holds
+             */
+            void unlink_chain( Node * first, Node * last, size_t count ) {
+                first->prev->next = last->next;
+                last->next->prev  = first->prev;
+                m_len -= count;
+            }
+
+            /**
+             * @brief Links the detached chain [first, last] before pos
+             *
+             * @param pos the node before which the chain is placed
+             * @param first the first node of the chain
+             * @param last the last node of the chain
+             * @param count how many nodes the chain holds
+             */
+            void link_chain( Node * pos, Node * first, Node * last, size_t count ) {
+                first->prev       = pos->prev;
+                first->prev->next = first;
+                last->next        = pos;
+                pos->prev         = last;
+                m_len += count;
+            }
+
+            /**
+             * @brief Finds how far the run starting at first goes. pred must hold for first,
+             * and once it fails for a node it must fail for every node after it.
+             *
+             * @param first the first node of the run
+             * @param stop the node where the search stops (not part of the run)
+             * @param pred tells whether a value belongs to the run
+             * @param count receives the length of the run
+             *
+             * @return the last node of the run
+             */
+            template < typename Pred >
+            static Node * gallop( Node * first, Node * stop, Pred pred, size_t & count ) {
+                auto good {first};
+                count = 1;
+
+                // Exponential search: probe 1, 2, 4, ... nodes ahead of the last known good node.
+                size_t gap {0};
+                for (size_t step {1}; ; step *= 2) {
+                    auto probe {good};
+                    for (gap = 0; gap < step and probe->next != stop; gap++)
+                        probe = probe->next;
+                    if (gap == 0)
+                        return good;
+                    if (not pred(probe->data))
+                        break;
+                    good = probe;
+                    count += gap;
+                    if (gap < step)
+                        return good;
+                }
+
+                // Binary search: good satisfies pred, the node gap steps ahead does not.
+                while (gap > 1) {
+                    auto half {gap / 2};
+                    auto mid {good};
+                    for (size_t i {0}; i < half; i++)
+                        mid = mid->next;
+                    if (pred(mid->data)) {
+                        good = mid;
+                        count += half;
+                        gap -= half;
+                    } else
+                        gap = half;
+                }
+                return good;
+            }
+
+            /**
+             * @brief Frees a chain of detached nodes
+             *
+             * @param first the first node of the chain, which is linked through next and ends in nullptr
+             */
+            void free_chain( Node * first ) {
+                while (first != nullptr) {
+                    auto next {first->next};
+                    recycle_node(first);
+                    first = next;
+                }
+            }
+
+            /**
+             * @brief Destroys a detached node and gives its memory back
+             *
+             * Nodes placed in a block by compact() are destroyed in place; the
+             * block itself goes once its last node does. The count is atomic
+             * because nodes of one block may end up in lists owned by different
+             * threads.
+             */
+            static void destroy_node( Node * node ) {
+                auto block {node->block};
+                if (block == nullptr) {
+                    node->~Node();
+                    node_cache< sizeof(Node), alignof(Node) >::release(node);
+                    return;
+                }
+                node->~Node();
+                if (block->live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete block;
+            }
+
+            /**
+             * @brief Gets memory for one node: from the spare pool, then from the node cache of
+             * the thread, and only then from the heap. In no-alloc mode only the spare pool is used.
+             *
+             * @param may_throw whether a failure throws or gives back nullptr
+             *
+             * @return the storage, or nullptr on failure when may_throw is false
+             */
+            void * node_storage( bool may_throw ) {
+                if (m_spare != nullptr) {
+                    auto storage {m_spare};
+                    m_spare = storage->next;
+                    m_spare_count--;
+                    return storage;
+                }
+                // In no-alloc mode the list only uses the nodes it reserved.
+                if (m_no_alloc) {
+                    if (may_throw)
+                        throw std::length_error("insert(): no spare node left in no-alloc mode.");
+                    return nullptr;
+                }
+                auto cached {node_cache< sizeof(Node), alignof(Node) >::take()};
+                if (cached != nullptr)
+                    return cached;
+                return may_throw ? raw_allocate< alignof(Node) >(sizeof(Node))
+                                 : raw_allocate< alignof(Node) >(sizeof(Node), std::nothrow);
+            }
+
+            /**
+             * @brief Puts the storage of a node, already destroyed, in the spare pool
+             */
+            void keep_storage( void * storage ) {
+                m_spare = new (storage) spare_node{m_spare};
+                m_spare_count++;
+            }
+
+            /**
+             * @brief Builds a detached node from args, drawing its memory from the spare pool first
+             *
+             * @throw std::length_error in no-alloc mode when the pool is empty
+             */
+            template < typename... Args >
+            Node * create_node( Args &&... args ) {
+                auto storage {node_storage(true)};
+                try {
+                    return new (storage) Node(std::forward<Args>(args)...);
+                } catch (...) {
+                    keep_storage(storage);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Like create_node(), but gives back nullptr instead of allocating in no-alloc mode
+             * or throwing std::bad_alloc. Exceptions from T's constructor still propagate.
+             */
+            template < typename... Args >
+            Node * try_create_node( Args &&... args ) {
+                auto storage {node_storage(false)};
+                if (storage == nullptr)
+                    return nullptr;
+                try {
+                    return new (storage) Node(std::forward<Args>(args)...);
+                } catch (...) {
+                    keep_storage(storage);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Builds a head or tail node, taking its memory from the node cache of the thread if it can
+             */
+            static Node * create_sentinel( void ) {
+                auto storage {node_cache< sizeof(Node), alignof(Node) >::take()};
+                if (storage == nullptr)
+                    storage = raw_allocate< alignof(Node) >(sizeof(Node));
+                try {
+                    return new (storage) Node;
+                } catch (...) {
+                    node_cache< sizeof(Node), alignof(Node) >::release(storage);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Destroys a detached node, keeping its memory in the spare pool while the
+             * list holds fewer nodes than reserve() asked for
+             */
+            void recycle_node( Node * node ) {
+                if (node->block == nullptr and m_len + m_spare_count < m_reserved) {
+                    node->~Node();
+                    keep_storage(node);
+                } else
+                    destroy_node(node);
+            }
+
+            /**
+             * @return whether every node of the list lives in a block, as compact() leaves them.
+             * Stops at the first node that does not.
+             */
+            bool in_blocks( void ) const {
+                for (auto node {m_head->next}; node != m_tail; node = node->next)
+                    if (node->block == nullptr)
+                        return false;
+                return true;
+            }
+
+            /**
+             * @brief Fills this list, which holds only its sentinels and m_len == clone.m_len > 0,
+             * with the values of clone, all in one new block. Only for a trivial_value T.
+             *
+             * Runs of clone that are laid out back to back are copied with one memcpy
+             * each, links included; the links are then rewritten in a sequential pass.
+             */
+            void copy_into_block( const list & clone ) {
+                auto block {new node_block{m_len}};
+                auto slots {block->slots};
+                size_t copied {0};
+                for (auto src {clone.m_head->next}; src != clone.m_tail; ) {
+                    size_t run {1};
+                    auto after {src->next};
+                    while (after != clone.m_tail and after->block != nullptr and after->block == src->block
+                           and after == src + run) {
+                        after = after->next;
+                        run++;
+                    }
+                    std::memcpy(static_cast< void * >(slots + copied), static_cast< const void * >(src), run * sizeof(Node));
+                    copied += run;
+                    src = after;
+                }
+
+                for (size_t i {0}; i < m_len; i++) {
+                    slots[i].prev  = i == 0 ? m_head : slots + i - 1;
+                    slots[i].next  = i + 1 == m_len ? m_tail : slots + i + 1;
+                    slots[i].block = block;
+                }
+                block->live.store(m_len, std::memory_order_relaxed);
+                m_head->next = slots;
+                m_tail->prev = slots + m_len - 1;
+            }
+
+            /**
+             * @return whether node directly follows prev in memory, as compact() lays nodes out
+             */
+            static bool follows( const Node * prev, const Node * node ) {
+                if (node->block == nullptr or prev->block == nullptr)
+                    return false;
+                if (node == prev + 1 and node->block == prev->block)
+                    return true;
+                // Across blocks: prev filled its block and node starts the next one.
+                return prev == prev->block->slots + prev->block->capacity - 1 and node == node->block->slots;
+            }
+
+            /**
+             * @brief Asks the cache for the links and the value of node ahead of their use
+             */
+            static void prefetch( const Node * node ) {
+                SC_PREFETCH(&node->next);
+                SC_PREFETCH(&node->data);
+            }
+
+            /*!
+             * A pointer that runs a few nodes ahead of a traversal and prefetches
+             * each node it reaches. A node is prefetched one step before the
+             * look-ahead pointer reads its link, and `distance` steps before the
+             * traversal itself gets there, so its cache miss overlaps with the
+             * work done on the nodes in between.
+             *
+             * \note
+             * The nodes ahead of the traversal must not be relinked while it runs.
+             */
+            struct lookahead {
+                const Node * ahead;
+                const Node * stop;
+
+                lookahead( const Node * first, const Node * stop_, size_t distance ) : ahead{first}, stop{stop_} {
+                    prefetch(ahead);
+                    for (size_t i {0}; i < distance; i++)
+                        advance();
+                }
+
+                void advance( void ) {
+                    if (ahead != stop) {
+                        ahead = ahead->next;
+                        prefetch(ahead);
+                    }
+                }
+            };
+
+            /**
+             * @brief Relinks the list in one pass so the values for which pred holds come first,
+             * keeping the relative order inside each group.
+             *
+             * @param pred the predicate
+             * @param rejected_count receives how many values pred rejected
+             *
+             * @return the first node for which pred does not hold (m_tail if there is none)
+             */
+            template < typename UnaryPredicate >
+            Node * partition_nodes( UnaryPredicate pred, size_t & rejected_count ) {
+                // The rejected nodes are chained aside, then linked back before the tail.
+                auto rejected_head {m_tail};
+                auto rejected_last {m_tail};
+                auto kept {m_head};
+                for (auto curr {m_head->next}; curr != m_tail; ) {
+                    auto next {curr->next};
+                    if (pred(curr->data)) {
+                        kept->next = curr;
+                        curr->prev = kept;
+                        kept = curr;
+                    } else {
+                        if (rejected_head == m_tail)
+                            rejected_head = curr;
+                        else {
+                            rejected_last->next = curr;
+                            curr->prev = rejected_last;
+                        }
+                        rejected_last = curr;
+                        rejected_count++;
+                    }
+                    curr = next;
+                }
+
+                if (rejected_head == m_tail) {
+                    kept->next = m_tail;
+                    m_tail->prev = kept;
+                } else {
+                    kept->next = rejected_head;
+                    rejected_head->prev = kept;
+                    rejected_last->next = m_tail;
+                    m_tail->prev = rejected_last;
+                }
+                return rejected_head;
+            }
+
         public:
             //=== Public interface
 
@@ -333,7 +942,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
             /**
              * @brief Constructs an empty list
              */
-            list() : m_len{0}, m_head{new Node}, m_tail{new Node} { 
+            list() : m_len{0}, m_head{create_sentinel()}, m_tail{create_sentinel()} { 
                 /*  Head & tail nodes.
                  *     +---+    +---+
                  *     |   |--->|   |--+
@@ -353,10 +962,10 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
              *
              * @param count the szie of the list
              */
-            explicit list( size_t count ) : m_len{count}, m_head{new Node}, m_tail{new Node} {
+            explicit list( size_t count ) : m_len{count}, m_head{create_sentinel()}, m_tail{create_sentinel()} {
                 auto prev {m_head};
                 for (auto i {0u}; i < count; i++) {
-                    auto curr {new Node};
+                    auto curr {create_node()};
                     prev->next = curr;
                     curr->prev = prev;
                     prev = curr;
@@ -368,12 +977,12 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
             template< typename InputIt >
             list( InputIt first, InputIt last ) 
                 : m_len{(size_t)std::distance(first,last)}, 
-                m_head{new Node}, 
-                m_tail{new Node}
+                m_head{create_sentinel()}, 
+                m_tail{create_sentinel()}
                 {
                     auto prev = m_head;
                     for (auto it {first}; it != last; it++) {
-                        auto curr {new Node{*it}};
+                        auto curr {create_node(*it)};
                         prev->next = curr;
                         curr->prev = prev;
                         prev = curr;
@@ -385,12 +994,25 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
             /**
              * @brief Creates a list with the values of clone
              *
+             * When T is trivially copyable and clone was fully compacted, the copy
+             * is laid out in one block as well (see copy_into_block()), with the
+             * memory trade-off compact() brings: the block is only freed when the
+             * last of its nodes is, and erased nodes do not give their slots back.
+             * A copy of any other list gets one allocation per node, so a list
+             * that was never compacted is not given that trade-off by copying it.
+             *
              * @param clone the list to create a new list from
              */
-            list( const list & clone ) : m_len{clone.m_len}, m_head{new Node}, m_tail{new Node} {
+            list( const list & clone ) : m_len{clone.m_len}, m_head{create_sentinel()}, m_tail{create_sentinel()} {
+                if constexpr (trivial_value) {
+                    if (m_len > 0 and clone.in_blocks()) {
+                        copy_into_block(clone);
+                        return;
+                    }
+                }
                 auto prev = m_head;
                 for (auto it {clone.cbegin()}; it != clone.cend(); it++) {
-                    auto curr {new Node{*it}};
+                    auto curr {create_node(*it)};
                     prev->next = curr;
                     curr->prev = prev;
                     prev = curr;
@@ -399,15 +1021,24 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 m_tail->prev = prev;
             }
 
+            /**
+             * @brief Creates a list taking over the values of other, without copying them
+             *
+             * @param other the list to move the values from; it becomes empty
+             */
+            list( list && other ) : list() {
+                splice(cbegin(), other);
+            }
+
             /**
              * @brief Creates a list from the values of ilist
              *
              * @param ilist the initializer_list to get the values from
              */
-            list( std::initializer_list<T> ilist ) : m_len{ilist.size()}, m_head{new Node}, m_tail{new Node}{ 
+            list( std::initializer_list<T> ilist ) : m_len{ilist.size()}, m_head{create_sentinel()}, m_tail{create_sentinel()}{ 
                 auto prev {m_head};
                 for (auto it {ilist.begin()}; it != ilist.end(); it++) {
-                    auto curr {new Node{*it}};
+                    auto curr {create_node(*it)};
                     prev->next = curr;
                     curr->prev = prev;
                     prev = curr;
@@ -417,9 +1048,11 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
             }
 
             ~list() { 
+                m_reserved = 0;
                 clear(); 
-                delete m_head;
-                delete m_tail;
+                shrink_to_fit();
+                destroy_node(m_head);
+                destroy_node(m_tail);
              }
 
             list & operator=( const list & rhs ) {
@@ -438,6 +1071,19 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 return *this;
             }
 
+            /**
+             * @brief Replaces the values of this list by the values of rhs, without copying them
+             *
+             * @param rhs the list to move the values from; it becomes empty
+             */
+            list & operator=( list && rhs ) {
+                if (this != &rhs) {
+                    clear();
+                    splice(cbegin(), rhs);
+                }
+                return *this;
+            }
+
             list & operator=( std::initializer_list<T> ilist ) {  
                 // Ensure the size this lsit is not greater than the other, liberating memory if necessary
                 if (m_len > ilist.size())
@@ -498,6 +1144,81 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 return m_len;
             }
 
+            /**
+             * @return how many values the list can hold without allocating: its size plus its spare nodes
+             */
+            size_t capacity( void ) const {
+                return m_len + m_spare_count;
+            }
+
+            /**
+             * @brief Allocates spare nodes now so the list can hold n values without allocating.
+             * Nodes erased later go back to the spare pool while the list is below n.
+             *
+             * @param n the capacity wanted
+             */
+            void reserve( size_t n ) {
+                if (n > m_reserved)
+                    m_reserved = n;
+                while (capacity() < n)
+                    keep_storage(raw_allocate< alignof(Node) >(sizeof(Node)));
+            }
+
+            /**
+             * @brief Gives the spare nodes away (to the node cache of the thread, or the heap)
+             * and forgets the capacity asked for by reserve()
+             */
+            void shrink_to_fit( void ) {
+                m_reserved = 0;
+                while (m_spare != nullptr) {
+                    auto next {m_spare->next};
+                    node_cache< sizeof(Node), alignof(Node) >::release(m_spare);
+                    m_spare = next;
+                }
+                m_spare_count = 0;
+            }
+
+            /**
+             * @brief Turns the no-alloc mode on or off. In no-alloc mode new nodes only come
+             * from the spare pool: when it is empty, insert() and the push/emplace methods
+             * throw std::length_error, and the try_ methods report the failure instead.
+             *
+             * @param on whether the list may not allocate
+             */
+            void set_no_alloc( bool on ) {
+                m_no_alloc = on;
+            }
+
+            /**
+             * @return whether the list is in no-alloc mode
+             */
+            bool no_alloc( void ) const {
+                return m_no_alloc;
+            }
+
+            /**
+             * @brief Sets how many free nodes the calling thread keeps for reuse by every list
+             * with nodes of this size (see node_cache). 0, the default, turns the cache off.
+             */
+            static void set_node_cache_limit( size_t n ) {
+                node_cache< sizeof(Node), alignof(Node) >::set_limit(n);
+            }
+
+            /**
+             * @return how many free nodes the node cache of the calling thread holds
+             */
+            static size_t node_cache_size( void ) {
+                return node_cache< sizeof(Node), alignof(Node) >::size();
+            }
+
+            /**
+             * @brief Frees cached nodes of the calling thread until at most keep are left.
+             * Meant to be called periodically, e.g. between requests.
+             */
+            static void trim_node_cache( size_t keep = 0 ) {
+                node_cache< sizeof(Node), alignof(Node) >::trim(keep);
+            }
+
             //=== [IV] Modifiers
             /**
              * @brief erases the values of the entire list
@@ -604,29 +1325,87 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
              *  \return An iterator to the new element in the list.
              */
             iterator insert( iterator pos, const T & value ) {
-                auto new_node {new Node{value}};
-                new_node->prev       = pos.m_ptr->prev;
-                new_node->prev->next = new_node;
-                new_node->next       = pos.m_ptr;
-                new_node->next->prev = new_node;
-
-                m_len++;
-
+                auto new_node {create_node(value)};
+                link_chain(pos.m_ptr, new_node, new_node, 1);
                 return iterator{new_node};
             }
 
             /**
-             * @brief Inserts the value of range [first, last) to position pos of the list
+             * @brief Inserts value before pos if a node is available: in no-alloc mode only
+             * the spare pool is used. Does not throw unless T's copy constructor does.
              *
-             * @tparam InItr an iterator type
-             * @param pos the position to insert the values
-             * @param first the begging of the range
-             * @param last the position after the end of the range
-             *
-             * @return and iterator to first inserted value on the list
+             * @return an iterator to the new element, or end() if there was no node for it
              */
-            template < typename InItr >
-            iterator insert( iterator pos, InItr first, InItr last ) { 
+            iterator try_insert( iterator pos, const T & value ) {
+                auto new_node {try_create_node(value)};
+                if (new_node == nullptr)
+                    return end();
+                link_chain(pos.m_ptr, new_node, new_node, 1);
+                return iterator{new_node};
+            }
+
+            /**
+             * @return whether value was added to the front (see try_insert())
+             */
+            bool try_push_front( const T & value ) {
+                return try_insert(begin(), value) != end();
+            }
+
+            /**
+             * @return whether value was added to the end (see try_insert())
+             */
+            bool try_push_back( const T & value ) {
+                return try_insert(end(), value) != end();
+            }
+
+            /**
+             * @brief Builds a value in place before pos from args
+             *
+             * @return an iterator to the new element
+             */
+            template < typename... Args >
+            iterator emplace( iterator pos, Args &&... args ) {
+                auto new_node {create_node(emplace_tag{}, std::forward<Args>(args)...)};
+                link_chain(pos.m_ptr, new_node, new_node, 1);
+                return iterator{new_node};
+            }
+
+            template < typename... Args >
+            void emplace_front( Args &&... args ) {
+                emplace(begin(), std::forward<Args>(args)...);
+            }
+
+            template < typename... Args >
+            void emplace_back( Args &&... args ) {
+                emplace(end(), std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Builds a value in place before pos if a node is available (see try_insert())
+             *
+             * @return an iterator to the new element, or end() if there was no node for it
+             */
+            template < typename... Args >
+            iterator try_emplace( iterator pos, Args &&... args ) {
+                auto new_node {try_create_node(emplace_tag{}, std::forward<Args>(args)...)};
+                if (new_node == nullptr)
+                    return end();
+                link_chain(pos.m_ptr, new_node, new_node, 1);
+                return iterator{new_node};
+            }
+
+            /**
+             * @brief Inserts the value of range [first, last) to position pos of the list
+             *
+             * @tparam InItr an iterator type
+             * @param pos the position to insert the values
+             * @param first the begging of the range
+             * @param last the position after the end of the range
+             *
+             * @return and iterator to first inserted value on the list
+             */
+            template < typename InItr >
+            iterator insert( iterator pos, InItr first, InItr last ) { 
                 // Go trough range and insert always at the same position
                 for (auto it {first}; it != last; it++)
                     insert(pos, *it);
@@ -654,7 +1433,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
 
                 auto to_return {it.m_ptr->next};
 
-                delete it.m_ptr;
+                recycle_node(it.m_ptr);
 
                 return iterator{to_return};
             }
@@ -666,10 +1445,33 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
 
                 m_len -= std::distance(start, end);
 
+                if constexpr (trivial_value) {
+                    // No destructor to run: the nodes of a block are given back a run at a
+                    // time, with one atomic update per run instead of one per node.
+                    auto curr {start.m_ptr};
+                    while (curr != end.m_ptr) {
+                        auto block {curr->block};
+                        if (block == nullptr) {
+                            auto next {curr->next};
+                            recycle_node(curr);
+                            curr = next;
+                            continue;
+                        }
+                        size_t run {0};
+                        while (curr != end.m_ptr and curr->block == block) {
+                            curr = curr->next;
+                            run++;
+                        }
+                        if (block->live.fetch_sub(run, std::memory_order_acq_rel) == run)
+                            delete block;
+                    }
+                    return end;
+                }
+
                 auto it {start};
                 while (it != end) {
                     auto new_it = std::next(it);
-                    delete it.m_ptr;
+                    recycle_node(it.m_ptr);
                     it = new_it;
                 }
                     
@@ -684,28 +1486,276 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
              * @param other the other list
              */
             void merge( list & other ) {
+                merge(other, std::less<T>{});
+            }
+
+            /**
+             * @brief Merge two lists already sorted by comp, keeping the result sorted.
+             * After it is done, the other list becomed empty.
+             *
+             * Runs of other that go before the current node of this list are
+             * relinked in one go. Once one side wins min_gallop times in a row, the
+             * runs are found by galloping (exponential then binary search), so
+             * merging a few elements into a long list takes O(m log n)
+             * comparisons. The merge is stable: equal elements of this list come
+             * first.
+             *
+             * @param other the other list
+             * @param comp the comparison that sorts both lists
+             */
+            template < typename Compare >
+            void merge( list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+
                 auto curr1 {m_head->next};
+                size_t streak1 {0}; // Consecutive wins of this list.
+                size_t streak2 {0}; // Consecutive wins of other.
+                bool galloping {false};
+                // Runs of other are linked before curr1, so the nodes ahead of it never move.
+                lookahead ahead {curr1, m_tail, prefetch_distance};
+
+                while (not other.empty()) {
+                    if (curr1 == m_tail) {
+                        // Everything left in other goes at the end.
+                        splice(cend(), other);
+                        break;
+                    }
+
+                    auto curr2 {other.m_head->next};
+                    prefetch(curr2->next);
+                    size_t count {1};
+                    if (comp(curr2->data, curr1->data)) {
+                        // Moves the run of other that goes before curr1.
+                        auto last {curr2};
+                        if (galloping or ++streak2 >= min_gallop) {
+                            last = gallop(curr2, other.m_tail, [&comp, curr1]( const T & value ) {
+                                return comp(value, curr1->data);
+                            }, count);
+                            // Keep galloping only while it pays off.
+                            galloping = count >= min_gallop;
+                            if (not galloping)
+                                streak2 = 0;
+                        }
+                        streak1 = 0;
+
+                        other.unlink_chain(curr2, last, count);
+                        link_chain(curr1, curr2, last, count);
+                    } else {
+                        // Skips the run of this list that goes before curr2.
+                        if (galloping or ++streak1 >= min_gallop) {
+                            curr1 = gallop(curr1, m_tail, [&comp, curr2]( const T & value ) {
+                                return not comp(curr2->data, value);
+                            }, count);
+                            galloping = count >= min_gallop;
+                            if (not galloping)
+                                streak1 = 0;
+                        }
+                        streak2 = 0;
+                        curr1 = curr1->next;
+                        ahead.advance();
+                    }
+                }
+            }
+
+            //=== Set algebra on sorted lists.
+            // Both lists must be sorted by the same comparison. Values are treated as a
+            // multiset, as in <algorithm>: the i-th equivalent value of one list is paired
+            // with the i-th equivalent value of the other. Nodes are only relinked, moved
+            // from other or freed, all discarded nodes together at the end.
+
+            /// Makes this list the sorted union of both lists; other becomes empty.
+            void set_union( list & other ) {
+                set_union(other, std::less<T>{});
+            }
 
+            /**
+             * @brief Makes this list the sorted union of both lists. After it is done, the other list becomes empty.
+             *
+             * The values of other without a pair in this list are moved in, and
+             * those with one are freed. Among equivalent values, those of this
+             * list come first.
+             *
+             * @param other the other list
+             * @param comp the comparison that sorts both lists
+             */
+            template < typename Compare >
+            void set_union( list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+
+                Node * garbage {nullptr};
+                auto curr1 {m_head->next};
                 while (not other.empty()) {
+                    if (curr1 == m_tail) {
+                        splice(cend(), other);
+                        break;
+                    }
+
                     auto curr2 {other.m_head->next};
+                    if (comp(curr2->data, curr1->data)) {
+                        // Moves the run of other that goes before curr1.
+                        auto last {curr2};
+                        size_t count {1};
+                        while (last->next != other.m_tail and comp(last->next->data, curr1->data)) {
+                            last = last->next;
+                            count++;
+                        }
+                        other.unlink_chain(curr2, last, count);
+                        link_chain(curr1, curr2, last, count);
+                        continue;
+                    }
+
+                    if (not comp(curr1->data, curr2->data)) {
+                        // Paired: the copy from other is dropped.
+                        other.unlink_chain(curr2, curr2, 1);
+                        curr2->next = garbage;
+                        garbage = curr2;
+                    }
+                    curr1 = curr1->next;
+                }
+
+                free_chain(garbage);
+            }
 
-                    if (curr1 == m_tail or curr2->data < curr1->data) {
-                        // Erase the curr value of the second list
-                        other.m_head->next = curr2->next;
-                        curr2->next->prev  = other.m_head;
+            /// Keeps only the values of this list that have a pair in other. other is not changed.
+            void set_intersection( const list & other ) {
+                set_intersection(other, std::less<T>{});
+            }
 
-                        // Inserts the curr value of second list before the curr value of first list
-                        curr2->prev       = curr1->prev;
-                        curr2->prev->next = curr2;
-                        curr2->next       = curr1;
-                        curr2->next->prev = curr2;
+            /**
+             * @brief Keeps only the values of this list that have a pair in other. other is not changed.
+             *
+             * @param other the other list
+             * @param comp the comparison that sorts both lists
+             */
+            template < typename Compare >
+            void set_intersection( const list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+
+                Node * garbage {nullptr};
+                auto curr1 {m_head->next};
+                auto curr2 {other.m_head->next};
+                while (curr1 != m_tail) {
+                    if (curr2 != other.m_tail and comp(curr2->data, curr1->data)) {
+                        curr2 = curr2->next;
+                        continue;
+                    }
+
+                    auto next {curr1->next};
+                    if (curr2 == other.m_tail or comp(curr1->data, curr2->data)) {
+                        unlink_chain(curr1, curr1, 1);
+                        curr1->next = garbage;
+                        garbage = curr1;
                     } else
-                        curr1 = curr1->next;
+                        curr2 = curr2->next;
+                    curr1 = next;
+                }
+
+                free_chain(garbage);
+            }
+
+            /// Removes from this list the values that have a pair in other. other is not changed.
+            void set_difference( const list & other ) {
+                set_difference(other, std::less<T>{});
+            }
+
+            /**
+             * @brief Removes from this list the values that have a pair in other. other is not changed.
+             *
+             * @param other the other list
+             * @param comp the comparison that sorts both lists
+             */
+            template < typename Compare >
+            void set_difference( const list & other, Compare comp ) {
+                if (&other == this) {
+                    clear();
+                    return;
+                }
+
+                Node * garbage {nullptr};
+                auto curr1 {m_head->next};
+                auto curr2 {other.m_head->next};
+                while (curr1 != m_tail and curr2 != other.m_tail) {
+                    if (comp(curr2->data, curr1->data)) {
+                        curr2 = curr2->next;
+                        continue;
+                    }
+
+                    auto next {curr1->next};
+                    if (not comp(curr1->data, curr2->data)) {
+                        unlink_chain(curr1, curr1, 1);
+                        curr1->next = garbage;
+                        garbage = curr1;
+                        curr2 = curr2->next;
+                    }
+                    curr1 = next;
+                }
+
+                free_chain(garbage);
+            }
+
+            /// Makes this list the sorted symmetric difference of both lists; other becomes empty.
+            void set_symmetric_difference( list & other ) {
+                set_symmetric_difference(other, std::less<T>{});
+            }
+
+            /**
+             * @brief Makes this list the sorted symmetric difference of both lists.
+             * After it is done, the other list becomes empty.
+             *
+             * Paired values are freed from both lists, and the values of other
+             * without a pair are moved in.
+             *
+             * @param other the other list
+             * @param comp the comparison that sorts both lists
+             */
+            template < typename Compare >
+            void set_symmetric_difference( list & other, Compare comp ) {
+                if (&other == this) {
+                    clear();
+                    return;
+                }
+
+                Node * garbage {nullptr};
+                auto curr1 {m_head->next};
+                while (not other.empty()) {
+                    if (curr1 == m_tail) {
+                        splice(cend(), other);
+                        break;
+                    }
+
+                    auto curr2 {other.m_head->next};
+                    if (comp(curr2->data, curr1->data)) {
+                        // Moves the run of other that goes before curr1.
+                        auto last {curr2};
+                        size_t count {1};
+                        while (last->next != other.m_tail and comp(last->next->data, curr1->data)) {
+                            last = last->next;
+                            count++;
+                        }
+                        other.unlink_chain(curr2, last, count);
+                        link_chain(curr1, curr2, last, count);
+                        continue;
+                    }
+
+                    auto next {curr1->next};
+                    if (not comp(curr1->data, curr2->data)) {
+                        // Paired: both values go.
+                        unlink_chain(curr1, curr1, 1);
+                        curr1->next = garbage;
+                        garbage = curr1;
+                        other.unlink_chain(curr2, curr2, 1);
+                        curr2->next = garbage;
+                        garbage = curr2;
+                    }
+                    curr1 = next;
                 }
 
-                m_len += other.m_len;
-                other.m_len = 0;
+                free_chain(garbage);
             }
+
             /**
              * @brief Moves the values of the other list to the position pos on this list
              *
@@ -713,20 +1763,90 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
              * @param other the other list
              */
             void splice( const_iterator pos, list & other ) {
-                // Links the first element of other after the element befere pos
-                pos.m_ptr->prev->next = other.m_head->next;
-                other.m_head->next->prev = pos.m_ptr->prev;
+                if (other.empty())
+                    return;
+
+                auto first {other.m_head->next};
+                auto last {other.m_tail->prev};
+                auto count {other.m_len};
+                other.unlink_chain(first, last, count);
+                link_chain(pos.m_ptr, first, last, count);
+            }
+
+            /**
+             * @brief Moves the element it of the other list to the position pos on this list.
+             * other may be this same list: moving a node to the front is O(1) and allocates nothing.
+             *
+             * @param pos the position to put the element
+             * @param other the list that holds it
+             * @param it the element to be moved
+             */
+            void splice( const_iterator pos, list & other, const_iterator it ) {
+                auto node {it.m_ptr};
+                if (pos.m_ptr == node or pos.m_ptr == node->next)
+                    return;
+
+                other.unlink_chain(node, node, 1);
+                link_chain(pos.m_ptr, node, node, 1);
+            }
+
+            /**
+             * @brief Moves the elements [first, last) of the other list to the position pos on this list.
+             * This walks the range to count it, unless other is this same list.
+             *
+             * @param pos the position to put the elements; it must not be inside [first, last)
+             * @param other the list that holds them
+             * @param first the first element to be moved
+             * @param last the element after the last one to be moved
+             */
+            void splice( const_iterator pos, list & other, const_iterator first, const_iterator last ) {
+                size_t count {0};
+                if (&other != this)
+                    count = size_t(std::distance(first, last));
+                splice(pos, other, first, last, count);
+            }
+
+            /**
+             * @brief Moves the elements [first, last) of the other list to the position pos on this list, in O(1).
+             *
+             * @param pos the position to put the elements; it must not be inside [first, last)
+             * @param other the list that holds them
+             * @param first the first element to be moved
+             * @param last the element after the last one to be moved
+             * @param count how many elements there are in [first, last)
+             */
+            void splice( const_iterator pos, list & other, const_iterator first, const_iterator last, size_t count ) {
+                if (first == last or pos == last)
+                    return;
 
-                // Links the last element of other befere pos
-                pos.m_ptr->prev = other.m_tail->prev;
-                other.m_tail->prev->next = pos.m_ptr;
+                auto last_node {last.m_ptr->prev};
+                other.unlink_chain(first.m_ptr, last_node, count);
+                link_chain(pos.m_ptr, first.m_ptr, last_node, count);
+            }
 
-                // Sets other as empty
-                other.m_head->next = other.m_tail;
-                other.m_tail->prev = other.m_head; 
+            /**
+             * @brief Cuts the list in two. This walks [pos, end) to count it.
+             *
+             * @param pos the first element of the second part
+             *
+             * @return a list holding the elements [pos, end), which are removed from this list
+             */
+            list split( const_iterator pos ) {
+                return split(pos, size_t(std::distance(pos, cend())));
+            }
 
-                m_len += other.m_len;
-                other.m_len = 0;
+            /**
+             * @brief Cuts the list in two, in O(1).
+             *
+             * @param pos the first element of the second part
+             * @param count how many elements there are in [pos, end)
+             *
+             * @return a list holding the elements [pos, end), which are removed from this list
+             */
+            list split( const_iterator pos, size_t count ) {
+                list tail_part;
+                tail_part.splice(tail_part.cend(), *this, pos, cend(), count);
+                return tail_part;
             }
 
             /**
@@ -746,21 +1866,325 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
             }
 
             /**
-             * @brief Remove duplicate values
+             * @brief Remove consecutive duplicate values
+             */
+            void unique( void ) {
+                unique(std::equal_to<T>{});
+            }
+
+            /**
+             * @brief Remove every value for which pred holds against the first value of its group
+             * of consecutive equivalent values.
+             *
+             * The list is relinked in a single pass and the removed nodes are freed
+             * together at the end.
+             *
+             * @param pred tells whether two values are duplicates
+             */
+            template < typename BinaryPredicate >
+            void unique( BinaryPredicate pred ) {
+                if (empty())
+                    return;
+
+                Node * garbage {nullptr};
+                auto kept {m_head->next};
+                lookahead ahead {kept, m_tail, prefetch_distance};
+                for (auto curr {kept->next}; curr != m_tail; ) {
+                    ahead.advance();
+                    auto next {curr->next};
+                    if (pred(kept->data, curr->data)) {
+                        curr->next = garbage;
+                        garbage = curr;
+                        m_len--;
+                    } else {
+                        kept->next = curr;
+                        curr->prev = kept;
+                        kept = curr;
+                    }
+                    curr = next;
+                }
+                kept->next = m_tail;
+                m_tail->prev = kept;
+
+                free_chain(garbage);
+            }
+
+            /**
+             * @brief Remove every duplicate value, consecutive or not, keeping the first occurrence.
+             *
+             * The values already seen are kept in an open-addressing hash set of
+             * node pointers, so the list does not need to be sorted and the whole
+             * pass takes O(n) expected time. The removed nodes are freed together
+             * at the end.
+             *
+             * @param hash the hash function of the values
+             * @param eq tells whether two values are equal
              */
-            void unique( void ){ 
-                auto first {m_head->next};
-                auto last {m_head->next->next};
-                while (first != m_tail) {
-                    if (first->data == last->data) {
-                        auto target = last;
-                        last = last->next;
-                        first->next = last;
-                        delete target;
+            template < typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T> >
+            void unique_all( Hash hash = Hash{}, KeyEqual eq = KeyEqual{} ) {
+                if (m_len <= 1)
+                    return;
+
+                // At most half full, with a power of two number of slots.
+                size_t bits {1};
+                while ((size_t(1) << bits) < 2 * m_len)
+                    bits++;
+                auto mask {(size_t(1) << bits) - 1};
+                std::vector< Node * > seen(mask + 1, nullptr);
+
+                Node * garbage {nullptr};
+                auto kept {m_head};
+                for (auto curr {m_head->next}; curr != m_tail; ) {
+                    auto next {curr->next};
+
+                    // Fibonacci hashing spreads weak hashes (std::hash<int> is the identity).
+                    auto slot {size_t((static_cast<unsigned long long>(hash(curr->data)) * 11400714819323198485ull) >> (64 - bits))};
+                    while (seen[slot] != nullptr and not eq(seen[slot]->data, curr->data))
+                        slot = (slot + 1) & mask;
+
+                    if (seen[slot] == nullptr) {
+                        seen[slot] = curr;
+                        kept->next = curr;
+                        curr->prev = kept;
+                        kept = curr;
+                    } else {
+                        curr->next = garbage;
+                        garbage = curr;
+                        m_len--;
+                    }
+                    curr = next;
+                }
+                kept->next = m_tail;
+                m_tail->prev = kept;
+
+                free_chain(garbage);
+            }
+
+            /**
+             * @brief Removes every value equal to value
+             *
+             * @param value the value to be removed; it may be an element of this list
+             */
+            void remove( const T & value ) {
+                // The nodes are only freed at the end, so value stays valid even if it lives in the list.
+                remove_if([&value]( const T & e ) { return e == value; });
+            }
+
+            /**
+             * @brief Removes every value for which pred holds
+             *
+             * The list is relinked in a single pass and the removed nodes are freed
+             * together at the end.
+             *
+             * @param pred tells whether a value must be removed
+             */
+            template < typename UnaryPredicate >
+            void remove_if( UnaryPredicate pred ) {
+                Node * garbage {nullptr};
+                auto kept {m_head};
+                for (auto curr {m_head->next}; curr != m_tail; ) {
+                    auto next {curr->next};
+                    if (pred(curr->data)) {
+                        curr->next = garbage;
+                        garbage = curr;
                         m_len--;
                     } else {
-                        first = first->next;
-                        last = last->next;
+                        kept->next = curr;
+                        curr->prev = kept;
+                        kept = curr;
+                    }
+                    curr = next;
+                }
+                kept->next = m_tail;
+                m_tail->prev = kept;
+
+                free_chain(garbage);
+            }
+
+            /**
+             * @brief Moves every value for which pred does not hold to the end of rejected.
+             * Both lists keep the relative order of their values.
+             *
+             * @param pred tells whether a value stays in this list
+             * @param rejected the list that receives the other values
+             */
+            template < typename UnaryPredicate >
+            void partition( UnaryPredicate pred, list & rejected ) {
+                size_t count {0};
+                auto first {partition_nodes(pred, count)};
+                if (count == 0)
+                    return;
+
+                auto last {m_tail->prev};
+                unlink_chain(first, last, count);
+                rejected.link_chain(rejected.m_tail, first, last, count);
+            }
+
+            /**
+             * @brief Reorders the list so the values for which pred holds come first,
+             * keeping the relative order inside each group.
+             *
+             * @param pred the predicate
+             *
+             * @return an iterator to the first value for which pred does not hold
+             */
+            template < typename UnaryPredicate >
+            iterator stable_partition( UnaryPredicate pred ) {
+                size_t rejected_count {0};
+                return iterator{partition_nodes(pred, rejected_count)};
+            }
+
+            /**
+             * @brief Reorders the list so the values for which pred holds come first.
+             * Relinking makes stability free, so this is the same as stable_partition().
+             *
+             * @param pred the predicate
+             *
+             * @return an iterator to the first value for which pred does not hold
+             */
+            template < typename UnaryPredicate >
+            iterator partition( UnaryPredicate pred ) {
+                return stable_partition(pred);
+            }
+
+            /**
+             * @brief Moves the k smallest values to the front of the list, in order.
+             * The order of the other values is unspecified.
+             */
+            void partial_sort( size_t k ) {
+                partial_sort(k, std::less<T>{});
+            }
+
+            /**
+             * @brief Moves the k values that go first according to comp to the front of the list, in order.
+             * The order of the other values is unspecified.
+             *
+             * A bounded max-heap keeps the k best nodes seen so far, so the whole
+             * pass takes O(n log k) comparisons and allocates room for only k
+             * entries. The winners are then relinked to the front: no value is
+             * copied and every iterator stays valid. Equal values keep their
+             * relative order, so the result is stable.
+             *
+             * @param k how many values to put in order at the front
+             * @param comp the comparison that defines the order
+             */
+            template < typename Compare >
+            void partial_sort( size_t k, Compare comp ) {
+                if (k > m_len)
+                    k = m_len;
+                if (k == 0)
+                    return;
+
+                // Each node is paired with its position, which breaks ties and makes the result stable.
+                using entry = std::pair< Node *, size_t >;
+                auto before = [&comp]( const entry & a, const entry & b ) {
+                    return comp(a.first->data, b.first->data) or (not comp(b.first->data, a.first->data) and a.second < b.second);
+                };
+
+                std::vector< entry > heap;
+                heap.reserve(k);
+                size_t position {0};
+                for (auto curr {m_head->next}; curr != m_tail; curr = curr->next, position++) {
+                    if (heap.size() < k) {
+                        heap.emplace_back(curr, position);
+                        std::push_heap(heap.begin(), heap.end(), before);
+                    } else if (comp(curr->data, heap.front().first->data)) {
+                        // Beats the worst winner so far (an equal value never does: it came later).
+                        std::pop_heap(heap.begin(), heap.end(), before);
+                        heap.back() = entry{curr, position};
+                        std::push_heap(heap.begin(), heap.end(), before);
+                    }
+                }
+                std::sort_heap(heap.begin(), heap.end(), before);
+
+                // Relinks the winners, in order, right after the head.
+                auto prev {m_head};
+                for (const auto & e : heap) {
+                    auto node {e.first};
+                    if (prev->next != node) {
+                        unlink_chain(node, node, 1);
+                        link_chain(prev->next, node, node, 1);
+                    }
+                    prev = node;
+                }
+            }
+
+            /**
+             * @brief Reorders the list so the value at position k is the one a full sort would put there.
+             * No value before it is greater, and no value after it is smaller.
+             */
+            void nth_element( size_t k ) {
+                nth_element(k, std::less<T>{});
+            }
+
+            /**
+             * @brief Reorders the list so the value at position k is the one a full sort by comp would put there.
+             * No value before it goes after it, and no value after it goes before it.
+             *
+             * Quickselect: the current range is split, by relinking, into the values
+             * that go before the pivot, those equivalent to it and those that go
+             * after it, and only the part holding position k is processed further.
+             * This takes O(n) expected comparisons, allocates nothing and keeps every
+             * iterator valid. The pivot is the middle value of the range, so already
+             * sorted input is not a bad case.
+             *
+             * @param k the position to settle; nothing happens if it is not less than size()
+             * @param comp the comparison that defines the order
+             */
+            template < typename Compare >
+            void nth_element( size_t k, Compare comp ) {
+                if (k >= m_len)
+                    return;
+
+                // The range being processed lies strictly between before and after.
+                auto before {m_head};
+                auto after {m_tail};
+                auto count {m_len};
+                while (count > 1) {
+                    auto pivot {before->next};
+                    for (size_t i {0}; i < count / 2; i++)
+                        pivot = pivot->next;
+                    // The pivot node lands in the middle group, so this reference stays valid.
+                    const auto & value {pivot->data};
+
+                    // Groups: 0 goes before the pivot, 1 is equivalent to it, 2 goes after it.
+                    Node * firsts[3] {nullptr, nullptr, nullptr};
+                    Node * lasts[3] {nullptr, nullptr, nullptr};
+                    size_t counts[3] {0, 0, 0};
+                    for (auto curr {before->next}; curr != after; ) {
+                        auto next {curr->next};
+                        auto group {comp(curr->data, value) ? 0 : (comp(value, curr->data) ? 2 : 1)};
+                        if (firsts[group] == nullptr)
+                            firsts[group] = curr;
+                        else {
+                            lasts[group]->next = curr;
+                            curr->prev = lasts[group];
+                        }
+                        lasts[group] = curr;
+                        counts[group]++;
+                        curr = next;
+                    }
+
+                    auto prev {before};
+                    for (auto group {0}; group < 3; group++) {
+                        if (firsts[group] == nullptr)
+                            continue;
+                        prev->next = firsts[group];
+                        firsts[group]->prev = prev;
+                        prev = lasts[group];
+                    }
+                    prev->next = after;
+                    after->prev = prev;
+
+                    if (k < counts[0]) {
+                        after = firsts[1];
+                        count = counts[0];
+                    } else if (k < counts[0] + counts[1]) {
+                        return;
+                    } else {
+                        k -= counts[0] + counts[1];
+                        before = lasts[1];
+                        count = counts[2];
                     }
                 }
             }
@@ -769,6 +2193,17 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
              * @brief Sort elements in container
              */
             void sort( void ) {
+                sort(std::less<T>{});
+            }
+
+            /**
+             * @brief Sorts the list by comp. The sort is stable and only relinks nodes,
+             * so every iterator stays valid.
+             *
+             * @param comp the comparison that defines the order
+             */
+            template < typename Compare >
+            void sort( Compare comp ) {
                 if (m_len <= 1)
                     return;
                 
@@ -801,14 +2236,145 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 list2.splice(list2.cbegin(), *this);
 
                 // Sorts the two halfs of the list, there are stored on list1 and list2
-                list1.sort();
-                list2.sort();
+                list1.sort(comp);
+                list2.sort(comp);
 
-                list1.merge(list2);
+                list1.merge(list2, comp);
 
                 // moves the values back to this list
                 splice(cbegin(), list1);
             }
+
+            /**
+             * @brief Sorts the list by comp applied to the projection of each value.
+             * The sort is stable.
+             *
+             * @param comp the comparison of the projected values
+             * @param proj the projection, called on every comparison; see sort_by_cached_key() when it is expensive
+             */
+            template < typename Compare, typename Projection >
+            void sort( Compare comp, Projection proj ) {
+                sort([&comp, &proj]( const T & a, const T & b ) { return comp(proj(a), proj(b)); });
+            }
+
+            /**
+             * @brief Sorts the list by the key of each value, computing every key only once.
+             * The sort is stable.
+             */
+            template < typename KeyFunction >
+            void sort_by_cached_key( KeyFunction key_fn ) {
+                using Key = typename std::decay< decltype(key_fn(std::declval< const T & >())) >::type;
+                sort_by_cached_key(key_fn, std::less< Key >{});
+            }
+
+            /**
+             * @brief Sorts the list by comp applied to the key of each value, computing every key only once.
+             * The sort is stable.
+             *
+             * The keys are stored next to their nodes in a side buffer, which is
+             * sorted with std::stable_sort; the nodes are then relinked in the
+             * buffer order. Every value is read once and the comparisons only
+             * touch the contiguous buffer, which pays off when the key is costly
+             * to derive or the values are large.
+             *
+             * @param key_fn computes the key of a value
+             * @param comp the comparison of the keys
+             */
+            template < typename KeyFunction, typename Compare >
+            void sort_by_cached_key( KeyFunction key_fn, Compare comp ) {
+                if (m_len <= 1)
+                    return;
+
+                using Key = typename std::decay< decltype(key_fn(std::declval< const T & >())) >::type;
+                std::vector< std::pair< Key, Node * > > keyed;
+                keyed.reserve(m_len);
+                for (auto curr {m_head->next}; curr != m_tail; curr = curr->next)
+                    keyed.emplace_back(key_fn(curr->data), curr);
+
+                std::stable_sort(keyed.begin(), keyed.end(), [&comp]( const std::pair< Key, Node * > & a, const std::pair< Key, Node * > & b ) {
+                    return comp(a.first, b.first);
+                });
+
+                auto prev {m_head};
+                for (const auto & entry : keyed) {
+                    prev->next = entry.second;
+                    entry.second->prev = prev;
+                    prev = entry.second;
+                }
+                prev->next = m_tail;
+                m_tail->prev = prev;
+            }
+
+            //=== [V-a] MEMORY LAYOUT
+            /**
+             * @brief Moves every node into contiguous storage, in traversal order,
+             * so a scan walks memory sequentially.
+             *
+             * \note
+             * Iterators, references and pointers to the moved elements are invalidated.
+             * There is no mode that keeps them: the speed-up comes from the new
+             * addresses. No other method relocates nodes, so calling compact() is
+             * the explicit opt-in.
+             *
+             * @return how many nodes were moved
+             */
+            size_t compact( void ) {
+                return compact(m_len);
+            }
+
+            /**
+             * @brief Moves at most budget nodes into contiguous storage, in traversal order.
+             *
+             * The walk skips the front of the list that earlier calls already laid
+             * out, which is a cheap sequential scan, and moves the next nodes into a
+             * new block of min(budget, nodes left) slots. Calling it repeatedly, in
+             * idle time for instance, ends with the whole list laid out in order;
+             * inserts and erases in between only leave more nodes to move. A value
+             * is moved when T is nothrow-move-constructible and copied otherwise. If
+             * a copy throws, the list is left intact.
+             *
+             * \note
+             * Iterators, references and pointers to the moved elements are invalidated.
+             *
+             * @param budget the most nodes to move in this call
+             *
+             * @return how many nodes were moved; 0 once the list is fully compacted
+             */
+            size_t compact( size_t budget ) {
+                // Skips the part of the list already laid out in order.
+                auto curr {m_head->next};
+                size_t settled {0};
+                if (curr != m_tail and curr->block != nullptr) {
+                    do {
+                        curr = curr->next;
+                        settled++;
+                    } while (curr != m_tail and follows(curr->prev, curr));
+                }
+
+                auto count {std::min(budget, m_len - settled)};
+                if (count == 0)
+                    return 0;
+
+                auto block {new node_block{count}};
+                size_t moved {0};
+                try {
+                    for (; moved < count; moved++) {
+                        auto next {curr->next};
+                        auto node {::new (block->slots + moved) Node{std::move_if_noexcept(curr->data), curr->next, curr->prev}};
+                        node->block = block;
+                        block->live.fetch_add(1, std::memory_order_relaxed);
+                        node->prev->next = node;
+                        node->next->prev = node;
+                        destroy_node(curr);
+                        curr = next;
+                    }
+                } catch (...) {
+                    if (moved == 0)
+                        delete block;
+                    throw;
+                }
+                return moved;
+            }
     };
 
     //=== [VI] OPETARORS
@@ -825,10 +2391,15 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
     inline bool operator==( const sc::list<T> & l1, const sc::list<T> & l2 ) {
         if (l1.size() != l2.size())
             return false;
-        auto it1 {l1.cbegin()};
-        auto it2 {l2.cbegin()};
-        while (it1 != l1.cend() && it2 != l2.cend()) {
-            if (*it1++ != *it2++)
+
+        // Both lists have the same length, so one look-ahead per list runs in step.
+        typename list<T>::lookahead ahead1 {l1.m_head->next, l1.m_tail, prefetch_distance};
+        typename list<T>::lookahead ahead2 {l2.m_head->next, l2.m_tail, prefetch_distance};
+        auto curr2 {l2.m_head->next};
+        for (auto curr1 {l1.m_head->next}; curr1 != l1.m_tail; curr1 = curr1->next, curr2 = curr2->next) {
+            ahead1.advance();
+            ahead2.advance();
+            if (curr1->data != curr2->data)
                 return false;
         }
         return true;
@@ -845,17 +2416,121 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
      */
     template < typename T >
     inline bool operator!=( const sc::list<T> & l1, const sc::list<T> & l2 ) {
-        if (l1.size() != l2.size())
-            return true;  
-        bool oneCase{ false };
-        auto it1 {l1.cbegin()};
-        auto it2 {l2.cbegin()};
-        while (it1 != l1.cend() && it2 != l2.cend()) {
-            if (*it1++ != *it2++)
-                oneCase = true;
+        return not (l1 == l2);
+    }
+
+    //=== [VII] ALGORITHMS
+    /**
+     * @brief Calls fn on every element of the list, in order, prefetching the nodes ahead
+     *
+     * A look-ahead pointer runs `distance` nodes ahead of the traversal and
+     * prefetches each node it reaches, so the cache misses of a list whose
+     * nodes are scattered over the heap overlap with the work fn does,
+     * instead of stalling every step. fn must not insert or erase elements.
+     *
+     * @param l the list
+     * @param fn the function applied to each element
+     * @param distance how many nodes ahead to prefetch
+     */
+    template < typename T, typename Function >
+    void for_each_prefetch( list<T> & l, Function fn, size_t distance ) {
+        typename list<T>::lookahead ahead {l.m_head->next, l.m_tail, distance};
+        for (auto curr {l.m_head->next}; curr != l.m_tail; curr = curr->next) {
+            ahead.advance();
+            fn(curr->data);
+        }
+    }
+
+    /**
+     * @brief Calls fn on every element of the list, in order, prefetching the nodes ahead
+     *
+     * @param l the list
+     * @param fn the function applied to each element
+     * @param distance how many nodes ahead to prefetch
+     */
+    template < typename T, typename Function >
+    void for_each_prefetch( const list<T> & l, Function fn, size_t distance ) {
+        typename list<T>::lookahead ahead {l.m_head->next, l.m_tail, distance};
+        for (const auto * curr {l.m_head->next}; curr != l.m_tail; curr = curr->next) {
+            ahead.advance();
+            fn(static_cast< const T & >(curr->data));
         }
-        return oneCase;
+    }
+
+    /**
+     * @brief Merges many sorted lists into one, keeping the result sorted.
+     * After it is done, every shard becomes empty.
+     *
+     * A loser tree over the shard heads picks the next node in O(log k)
+     * comparisons, and the node is relinked to the output: no element is
+     * copied and no node is allocated. Equal elements keep the order of their
+     * shards, so the merge is stable.
+     *
+     * @tparam T any type
+     * @param shards the sorted lists to merge
+     * @param comp the comparison that sorts the shards
+     *
+     * @return the merged list
+     */
+    template < typename T, typename Compare >
+    list<T> merge_all( std::vector< list<T> > & shards, Compare comp ) {
+        list<T> merged;
+        auto k {shards.size()};
+
+        // Whether shard a must be taken before shard b. Exhausted shards always lose.
+        auto beats = [&shards, &comp]( size_t a, size_t b ) {
+            if (b >= shards.size() or shards[b].empty())
+                return true;
+            if (a >= shards.size() or shards[a].empty())
+                return false;
+            const auto & head_a {shards[a].m_head->next->data};
+            const auto & head_b {shards[b].m_head->next->data};
+            return comp(head_a, head_b) or (not comp(head_b, head_a) and a < b);
+        };
+
+        // Leaves live at [width, 2 * width); missing leaves behave as exhausted shards.
+        size_t width {1};
+        while (width < k)
+            width *= 2;
+        std::vector< size_t > losers(width);
+        std::vector< size_t > winners(2 * width);
+        for (size_t i {0}; i < width; i++)
+            winners[width + i] = i;
+        for (auto node {width - 1}; node >= 1; node--) {
+            auto left {winners[2 * node]};
+            auto right {winners[2 * node + 1]};
+            winners[node] = beats(left, right) ? left : right;
+            losers[node]  = beats(left, right) ? right : left;
+        }
+        auto winner {winners[1]};
+
+        while (winner < k and not shards[winner].empty()) {
+            auto & shard {shards[winner]};
+            auto node {shard.m_head->next};
+            shard.unlink_chain(node, node, 1);
+            merged.link_chain(merged.m_tail, node, node, 1);
+
+            // Replays the matches on the path from the winner's leaf to the root.
+            for (auto parent {(width + winner) / 2}; parent >= 1; parent /= 2)
+                if (beats(losers[parent], winner))
+                    std::swap(losers[parent], winner);
+        }
+
+        return merged;
+    }
+
+    /**
+     * @brief Merges many lists sorted by operator< into one, keeping the result sorted.
+     * After it is done, every shard becomes empty.
+     *
+     * @tparam T any type
+     * @param shards the sorted lists to merge
+     *
+     * @return the merged list
+     */
+    template < typename T >
+    list<T> merge_all( std::vector< list<T> > & shards ) {
+        return merge_all(shards, std::less<T>{});
     }
 }
 #endif
-
@@ -0,0 +1,393 @@
+#ifndef _LRU_CACHE_H_
+#define _LRU_CACHE_H_
+
+#include <cstddef>    // size_t
+#include <functional> // function, hash, equal_to
+#include <iterator>   // prev
+#include <stdexcept>  // invalid_argument
+#include <vector>     // vector
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * An open-addressing hash table of list node handles (iterators), looked up
+     * by a key read from the node itself. Linear probing, at most half full,
+     * with backward-shift deletion so no tombstone is ever left behind.
+     *
+     * \note
+     * The table never grows: it is sized for the capacity given to it.
+     */
+    template < typename Key, typename Handle, typename KeyOf, typename Hash, typename KeyEqual >
+    class handle_index {
+        private:
+            std::vector< Handle > m_slots; //!< Handle{} marks an empty slot.
+            size_t m_bits;                 //!< log2 of the number of slots.
+            KeyOf m_key_of;
+            Hash m_hash;
+            KeyEqual m_eq;
+
+            /**
+             * @return the preferred slot of key (Fibonacci hashing, to spread weak hashes)
+             */
+            size_t home( const Key & key ) const {
+                return size_t((static_cast<unsigned long long>(m_hash(key)) * 11400714819323198485ull) >> (64 - m_bits));
+            }
+
+            /**
+             * @return the slot holding key, or the empty slot where it would go
+             */
+            size_t slot_of( const Key & key ) const {
+                auto mask {m_slots.size() - 1};
+                auto slot {home(key)};
+                while (m_slots[slot] != Handle{} and not m_eq(m_key_of(m_slots[slot]), key))
+                    slot = (slot + 1) & mask;
+                return slot;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty index able to hold capacity handles
+             */
+            explicit handle_index( size_t capacity, Hash hash = Hash{}, KeyEqual eq = KeyEqual{} )
+                : m_slots{}, m_bits{1}, m_key_of{}, m_hash{hash}, m_eq{eq} {
+                while ((size_t(1) << m_bits) < 2 * capacity)
+                    m_bits++;
+                m_slots.assign(size_t(1) << m_bits, Handle{});
+            }
+
+            /**
+             * @return the handle whose key is key, or Handle{} if there is none
+             */
+            Handle find( const Key & key ) const {
+                return m_slots[slot_of(key)];
+            }
+
+            /**
+             * @brief Stores handle, replacing the handle with the same key if there is one
+             */
+            void assign( Handle handle ) {
+                m_slots[slot_of(m_key_of(handle))] = handle;
+            }
+
+            /**
+             * @brief Removes the handle whose key is key, if there is one
+             */
+            void erase( const Key & key ) {
+                auto mask {m_slots.size() - 1};
+                auto hole {slot_of(key)};
+                if (m_slots[hole] == Handle{})
+                    return;
+
+                // Backward shift: pull later entries of the cluster into the hole when that
+                // brings them closer to their home slot.
+                auto slot {hole};
+                while (true) {
+                    slot = (slot + 1) & mask;
+                    if (m_slots[slot] == Handle{})
+                        break;
+                    auto slot_home {home(m_key_of(m_slots[slot]))};
+                    if (((slot - slot_home) & mask) >= ((slot - hole) & mask)) {
+                        m_slots[hole] = m_slots[slot];
+                        hole = slot;
+                    }
+                }
+                m_slots[hole] = Handle{};
+            }
+    };
+
+    /*!
+     * A fixed-capacity least-recently-used cache.
+     *
+     * Entries live in an sc::list, most recently used first, and are found
+     * through a handle_index that maps each key to its list node. A hit moves
+     * the node to the front with a single-node splice. A miss on a full cache
+     * reuses the node of the evicted entry, so once the cache is full no
+     * operation allocates.
+     */
+    template < typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K> >
+    class lru_cache {
+        public:
+            /// Called with the key and value of every evicted entry.
+            using evict_callback = std::function< void( const K &, V & ) >;
+
+        private:
+            struct entry {
+                K key;
+                V value;
+            };
+            using handle = typename list<entry>::iterator;
+
+            struct key_of {
+                const K & operator()( const handle & h ) const { return (*h).key; }
+            };
+
+            list<entry> m_entries;                                   //!< Most recently used first.
+            handle_index< K, handle, key_of, Hash, KeyEqual > m_index;
+            size_t m_capacity;
+            evict_callback m_on_evict;
+            size_t m_hits;
+            size_t m_misses;
+
+        public:
+            /**
+             * @brief Constructs an empty cache
+             *
+             * @param capacity the most entries the cache holds
+             * @param on_evict called for every entry evicted to make room (optional)
+             */
+            explicit lru_cache( size_t capacity, evict_callback on_evict = nullptr )
+                : m_entries{}, m_index{capacity}, m_capacity{capacity}, m_on_evict{on_evict}, m_hits{0}, m_misses{0} {
+                if (capacity == 0)
+                    throw std::invalid_argument("lru_cache(): the capacity must be positive.");
+            }
+
+            lru_cache( const lru_cache & ) = delete;
+            lru_cache & operator=( const lru_cache & ) = delete;
+
+            /**
+             * @brief Looks key up, marking it as the most recently used entry
+             *
+             * @param key the key
+             *
+             * @return a pointer to the value, or nullptr on a miss
+             */
+            V * get( const K & key ) {
+                auto h {m_index.find(key)};
+                if (h == handle{}) {
+                    m_misses++;
+                    return nullptr;
+                }
+
+                m_hits++;
+                m_entries.splice(m_entries.cbegin(), m_entries, h);
+                return &(*h).value;
+            }
+
+            /**
+             * @brief Inserts or updates key, marking it as the most recently used entry.
+             * If the cache is full, the least recently used entry is evicted.
+             *
+             * @param key the key
+             * @param value the value
+             */
+            void put( const K & key, const V & value ) {
+                auto h {m_index.find(key)};
+                if (h != handle{}) {
+                    (*h).value = value;
+                    m_entries.splice(m_entries.cbegin(), m_entries, h);
+                    return;
+                }
+
+                if (m_entries.size() < m_capacity) {
+                    m_entries.push_front(entry{key, value});
+                    m_index.assign(m_entries.begin());
+                    return;
+                }
+
+                // Full: the least recently used node is recycled for the new entry.
+                auto victim {std::prev(m_entries.end())};
+                if (m_on_evict)
+                    m_on_evict((*victim).key, (*victim).value);
+                m_index.erase((*victim).key);
+                (*victim).key = key;
+                (*victim).value = value;
+                m_entries.splice(m_entries.cbegin(), m_entries, victim);
+                m_index.assign(victim);
+            }
+
+            /**
+             * @brief Removes key from the cache, without calling the eviction callback
+             *
+             * @return whether key was in the cache
+             */
+            bool erase( const K & key ) {
+                auto h {m_index.find(key)};
+                if (h == handle{})
+                    return false;
+
+                m_index.erase(key);
+                m_entries.erase(h);
+                return true;
+            }
+
+            /**
+             * @return whether key is in the cache. Does not change its recency.
+             */
+            bool contains( const K & key ) const {
+                return m_index.find(key) != handle{};
+            }
+
+            size_t size( void ) const { return m_entries.size(); }
+            size_t capacity( void ) const { return m_capacity; }
+            bool empty( void ) const { return m_entries.empty(); }
+            size_t hits( void ) const { return m_hits; }
+            size_t misses( void ) const { return m_misses; }
+    };
+
+    /*!
+     * A fixed-capacity least-frequently-used cache; ties are broken by recency.
+     *
+     * All entries live in one sc::list ordered by use count, and the entries
+     * with the same count form a contiguous run, oldest first: the list is the
+     * concatenation of the per-frequency lists. A second handle_index maps
+     * each count to the last node of its run, so a hit moves the node to the
+     * end of the next run with one single-node splice. The victim is always the
+     * first node. Once the cache is full no operation allocates.
+     */
+    template < typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K> >
+    class lfu_cache {
+        public:
+            /// Called with the key and value of every evicted entry.
+            using evict_callback = std::function< void( const K &, V & ) >;
+
+        private:
+            struct entry {
+                K key;
+                V value;
+                size_t uses;
+            };
+            using handle = typename list<entry>::iterator;
+
+            struct key_of {
+                const K & operator()( const handle & h ) const { return (*h).key; }
+            };
+            struct uses_of {
+                const size_t & operator()( const handle & h ) const { return (*h).uses; }
+            };
+
+            list<entry> m_entries;                                            //!< By use count, then oldest first.
+            handle_index< K, handle, key_of, Hash, KeyEqual > m_index;
+            handle_index< size_t, handle, uses_of, std::hash<size_t>, std::equal_to<size_t> > m_run_last; //!< Last node of each use count.
+            size_t m_capacity;
+            evict_callback m_on_evict;
+
+            /**
+             * @brief Takes h out of the run of its use count
+             */
+            void leave_run( handle h ) {
+                if (m_run_last.find((*h).uses) != h)
+                    return;
+
+                // h closed its run: the run now ends just before it, or is gone.
+                if (h != m_entries.begin() and (*std::prev(h)).uses == (*h).uses)
+                    m_run_last.assign(std::prev(h));
+                else
+                    m_run_last.erase((*h).uses);
+            }
+
+            /**
+             * @brief Moves h, already out of its old run, to the end of the run of its use count
+             */
+            void join_run( handle h, handle after ) {
+                auto last {m_run_last.find((*h).uses)};
+                if (last != handle{})
+                    after = last;
+
+                // Link right after `after` (or at the front when there is none).
+                auto pos {after == handle{} ? m_entries.begin() : std::next(after)};
+                m_entries.splice(pos, m_entries, h);
+                m_run_last.assign(h);
+            }
+
+            /**
+             * @brief Counts one more use of h
+             */
+            void touch( handle h ) {
+                // A new run goes right after what is left of h's old run.
+                auto before {m_run_last.find((*h).uses)};
+                if (before == h)
+                    before = h == m_entries.begin() ? handle{} : std::prev(h);
+                leave_run(h);
+                (*h).uses++;
+                join_run(h, before);
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty cache
+             *
+             * @param capacity the most entries the cache holds
+             * @param on_evict called for every entry evicted to make room (optional)
+             */
+            explicit lfu_cache( size_t capacity, evict_callback on_evict = nullptr )
+                : m_entries{}, m_index{capacity}, m_run_last{capacity}, m_capacity{capacity}, m_on_evict{on_evict} {
+                if (capacity == 0)
+                    throw std::invalid_argument("lfu_cache(): the capacity must be positive.");
+            }
+
+            lfu_cache( const lfu_cache & ) = delete;
+            lfu_cache & operator=( const lfu_cache & ) = delete;
+
+            /**
+             * @brief Looks key up, counting one more use of it
+             *
+             * @param key the key
+             *
+             * @return a pointer to the value, or nullptr on a miss
+             */
+            V * get( const K & key ) {
+                auto h {m_index.find(key)};
+                if (h == handle{})
+                    return nullptr;
+
+                touch(h);
+                return &(*h).value;
+            }
+
+            /**
+             * @brief Inserts or updates key, counting one more use of it.
+             * If the cache is full, the least frequently used entry is evicted.
+             *
+             * @param key the key
+             * @param value the value
+             */
+            void put( const K & key, const V & value ) {
+                auto h {m_index.find(key)};
+                if (h != handle{}) {
+                    (*h).value = value;
+                    touch(h);
+                    return;
+                }
+
+                if (m_entries.size() < m_capacity) {
+                    m_entries.push_front(entry{key, value, 1});
+                    h = m_entries.begin();
+                } else {
+                    // Full: the first node (fewest uses, oldest) is recycled for the new entry.
+                    h = m_entries.begin();
+                    if (m_on_evict)
+                        m_on_evict((*h).key, (*h).value);
+                    leave_run(h);
+                    m_index.erase((*h).key);
+                    (*h).key = key;
+                    (*h).value = value;
+                    (*h).uses = 1;
+                }
+
+                m_index.assign(h);
+                // Runs with a single use come first.
+                join_run(h, handle{});
+            }
+
+            /**
+             * @return how many times key was used, or 0 if it is not in the cache
+             */
+            size_t uses( const K & key ) const {
+                auto h {m_index.find(key)};
+                return h == handle{} ? 0 : (*h).uses;
+            }
+
+            /**
+             * @return whether key is in the cache. Does not count as a use.
+             */
+            bool contains( const K & key ) const {
+                return m_index.find(key) != handle{};
+            }
+
+            size_t size( void ) const { return m_entries.size(); }
+            size_t capacity( void ) const { return m_capacity; }
+            bool empty( void ) const { return m_entries.empty(); }
+    };
+}
+#endif
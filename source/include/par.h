@@ -0,0 +1,444 @@
+#ifndef _PAR_H_
+#define _PAR_H_
+
+#include <algorithm>          // min, max, find, inplace_merge, partition_point
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t
+#include <exception>          // exception_ptr, current_exception, rethrow_exception
+#include <functional>         // less
+#include <iterator>           // next, prev
+#include <memory>             // unique_ptr
+#include <mutex>              // mutex, unique_lock
+#include <thread>             // thread, hardware_concurrency
+#include <utility>            // move
+#include <vector>             // vector
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * Parallel algorithms over sc::list.
+     *
+     * The list is cut into one segment per worker with a single stride walk,
+     * which is cheap compared with the per-element work these algorithms are
+     * meant for. The segments are shared between the calling thread and the
+     * threads of a pool that lives as long as the program, so no thread is
+     * started per call. An exception thrown by the callable is rethrown in the
+     * calling thread once every segment is done.
+     */
+    namespace par {
+        /// Below this many elements per worker, merge() falls back to list::merge.
+        constexpr size_t min_merge_segment{ 4096 };
+
+        /// Nodes merge() samples from each list per worker to choose its splitters.
+        constexpr size_t merge_samples{ 16 };
+
+        /// Number of chunks reduce() folds separately; fixed so the result does not depend on the machine.
+        constexpr size_t reduce_chunks{ 64 };
+
+        /**
+         * @return the number of workers used when the caller does not choose
+         */
+        inline size_t default_workers( void ) {
+            auto n {std::thread::hardware_concurrency()};
+            return n == 0 ? 1 : n;
+        }
+
+        /**
+         * @brief Cuts [first, first + size) into at most n_segments contiguous segments of roughly equal length
+         *
+         * @return the n + 1 boundaries of the n segments
+         */
+        template < typename It >
+        std::vector< It > split_points( It first, size_t size, size_t n_segments ) {
+            if (n_segments > size)
+                n_segments = size;
+            if (n_segments == 0)
+                n_segments = 1;
+
+            std::vector< It > points;
+            points.reserve(n_segments + 1);
+            points.push_back(first);
+
+            size_t pos {0};
+            for (size_t i {1}; i <= n_segments; i++) {
+                auto next_pos {size * i / n_segments};
+                first = std::next(first, next_pos - pos);
+                pos = next_pos;
+                points.push_back(first);
+            }
+            return points;
+        }
+
+        /*!
+         * A fixed set of threads that run batches of indexed tasks.
+         *
+         * run() hands the tasks of a batch out one at a time, to the pool threads
+         * and to the calling thread, which keeps taking tasks until none is left
+         * and only then waits for the ones still running. A task may therefore
+         * call run() itself: the nested batch is always finished by its caller,
+         * even when every pool thread is busy.
+         */
+        class thread_pool {
+            private:
+                /// One call to run(), shared by the threads working on it.
+                struct batch {
+                    void (*call)( void *, size_t ); //!< Calls the task with an index.
+                    void * task;
+                    size_t size;                    //!< Number of tasks.
+                    size_t next;                    //!< First task nobody has taken yet.
+                    size_t finished;                //!< Tasks done so far.
+                    std::vector< std::exception_ptr > errors;
+                };
+
+                std::vector< std::thread > m_threads;
+                std::vector< batch * > m_batches; //!< Batches that still have tasks to hand out.
+                std::mutex m_mutex;
+                std::condition_variable m_wake;   //!< Signalled when a batch arrives or the pool stops.
+                std::condition_variable m_done;   //!< Signalled when a task finishes.
+                bool m_stop;
+
+                /**
+                 * @brief Takes the next task of b. Must be called with m_mutex held.
+                 *
+                 * @return the index of the task
+                 */
+                size_t take( batch * b ) {
+                    auto i {b->next++};
+                    if (b->next == b->size)
+                        m_batches.erase(std::find(m_batches.begin(), m_batches.end(), b));
+                    return i;
+                }
+
+                /**
+                 * @brief Runs task i of b, keeping what it throws. Called without m_mutex.
+                 */
+                static void execute( batch * b, size_t i ) {
+                    try { b->call(b->task, i); }
+                    catch (...) { b->errors[i] = std::current_exception(); }
+                }
+
+                void work( void ) {
+                    std::unique_lock< std::mutex > lock {m_mutex};
+                    while (true) {
+                        m_wake.wait(lock, [this]() { return m_stop or not m_batches.empty(); });
+                        if (m_batches.empty())
+                            return;
+                        auto b {m_batches.front()};
+                        auto i {take(b)};
+                        lock.unlock();
+                        execute(b, i);
+                        lock.lock();
+                        if (++b->finished == b->size)
+                            m_done.notify_all();
+                    }
+                }
+
+            public:
+                /**
+                 * @param n_threads how many threads the pool starts, besides the callers of run()
+                 */
+                explicit thread_pool( size_t n_threads ) : m_stop{false} {
+                    m_threads.reserve(n_threads);
+                    for (size_t i {0}; i < n_threads; i++)
+                        m_threads.emplace_back([this]() { work(); });
+                }
+
+                thread_pool( const thread_pool & ) = delete;
+                thread_pool & operator=( const thread_pool & ) = delete;
+
+                ~thread_pool() {
+                    {
+                        std::lock_guard< std::mutex > lock {m_mutex};
+                        m_stop = true;
+                    }
+                    m_wake.notify_all();
+                    for (auto & thread : m_threads)
+                        thread.join();
+                }
+
+                /**
+                 * @return how many threads the pool has, not counting the callers of run()
+                 */
+                size_t size( void ) const { return m_threads.size(); }
+
+                /**
+                 * @brief Runs task(i) for every i in [0, n_tasks) and waits for all of them.
+                 * The first exception thrown, in index order, is rethrown here.
+                 */
+                template < typename Task >
+                void run( size_t n_tasks, Task & task ) {
+                    if (n_tasks == 0)
+                        return;
+                    batch b {[]( void * t, size_t i ) { (*static_cast< Task * >(t))(i); }, &task,
+                             n_tasks, 0, 0, std::vector< std::exception_ptr >(n_tasks)};
+
+                    std::unique_lock< std::mutex > lock {m_mutex};
+                    if (n_tasks > 1 and not m_threads.empty()) {
+                        m_batches.push_back(&b);
+                        m_wake.notify_all();
+                    }
+                    while (b.next < b.size) {
+                        auto i {n_tasks > 1 and not m_threads.empty() ? take(&b) : b.next++};
+                        lock.unlock();
+                        execute(&b, i);
+                        lock.lock();
+                        ++b.finished;
+                    }
+                    m_done.wait(lock, [&b]() { return b.finished == b.size; });
+                    lock.unlock();
+
+                    for (auto & error : b.errors)
+                        if (error)
+                            std::rethrow_exception(error);
+                }
+        };
+
+        /**
+         * @return the pool shared by the algorithms of this namespace, started on first use
+         * with one thread less than default_workers(), and at least one
+         */
+        inline thread_pool & default_pool( void ) {
+            static thread_pool pool {std::max< size_t >(default_workers(), 2) - 1};
+            return pool;
+        }
+
+        /**
+         * @brief Runs task(i) for every segment i on the shared pool, the calling thread included
+         *
+         * @param n_segments the number of segments
+         * @param task the work for one segment
+         */
+        template < typename Task >
+        void run_segments( size_t n_segments, Task task ) {
+            default_pool().run(n_segments, task);
+        }
+
+        /**
+         * @brief Calls fn on every element of the list, in parallel
+         *
+         * @param l the list
+         * @param fn the function applied to each element
+         * @param n_workers how many threads to use (0 for one per core)
+         */
+        template < typename T, typename Function >
+        void for_each( list<T> & l, Function fn, size_t n_workers = 0 ) {
+            auto points {split_points(l.begin(), l.size(), n_workers == 0 ? default_workers() : n_workers)};
+
+            run_segments(points.size() - 1, [&points, &fn]( size_t i ) {
+                for (auto it {points[i]}; it != points[i + 1]; ++it)
+                    fn(*it);
+            });
+        }
+
+        /**
+         * @brief Replaces every element x of the list by fn(x), in parallel
+         *
+         * @param l the list
+         * @param fn the transformation
+         * @param n_workers how many threads to use (0 for one per core)
+         */
+        template < typename T, typename Function >
+        void transform_inplace( list<T> & l, Function fn, size_t n_workers = 0 ) {
+            for_each(l, [&fn]( T & value ) { value = fn(value); }, n_workers);
+        }
+
+        /**
+         * @brief Combines init and every element of the list with op, in parallel
+         *
+         * The list is cut into reduce_chunks chunks (fewer for short lists),
+         * whatever the number of workers. Each chunk is folded from left to
+         * right, the workers share the chunks between them, and the partial
+         * results are then folded into init in chunk order. For the same list
+         * the result is always the same, on any machine and with any number of
+         * workers, even when op is not associative (floating point sums, for
+         * instance).
+         *
+         * @param l the list
+         * @param init the initial value
+         * @param op the binary operation
+         * @param n_workers how many threads to use (0 for one per core)
+         *
+         * @return the reduced value
+         */
+        template < typename T, typename BinaryOp >
+        T reduce( const list<T> & l, T init, BinaryOp op, size_t n_workers = 0 ) {
+            if (l.empty())
+                return init;
+
+            auto points {split_points(l.cbegin(), l.size(), reduce_chunks)};
+            auto n_chunks {points.size() - 1};
+            if (n_workers == 0)
+                n_workers = default_workers();
+            n_workers = std::min(n_workers, n_chunks);
+
+            // One heap slot per chunk: T need not be default-constructible, and a
+            // vector<bool> would pack the workers' results into shared words.
+            std::vector< std::unique_ptr< T > > partial(n_chunks);
+
+            run_segments(n_workers, [&points, &partial, &op, n_chunks, n_workers]( size_t w ) {
+                for (auto i {n_chunks * w / n_workers}; i < n_chunks * (w + 1) / n_workers; i++) {
+                    auto it {points[i]};
+                    T acc {*it};
+                    for (++it; it != points[i + 1]; ++it)
+                        acc = op(acc, *it);
+                    partial[i].reset(new T(std::move(acc)));
+                }
+            });
+
+            for (const auto & value : partial)
+                init = op(init, *value);
+            return init;
+        }
+
+        /**
+         * @brief Merges two already sorted lists in parallel, keeping the result sorted.
+         * After it is done, the other list becomes empty.
+         *
+         * @param l the list that receives the result
+         * @param other the other list
+         * @param n_workers how many threads to use (0 for one per core)
+         */
+        template < typename T >
+        void merge( list<T> & l, list<T> & other, size_t n_workers ) {
+            merge(l, other, std::less<T>{}, n_workers);
+        }
+
+        /**
+         * @brief Merges two lists already sorted by comp in parallel, keeping the result sorted.
+         * After it is done, the other list becomes empty.
+         *
+         * Every list is sampled, following the links only, by two workers: one
+         * walks its first half from the front, the other its second half from
+         * the back, each keeping every stride-th node (merge_samples per worker
+         * and list). The splitters are taken at equal ranks of the two samples
+         * merged together, and the cut of each list for each splitter is
+         * searched in parallel, from the last sampled node before it. Besides
+         * the walks, the serial part only merges the samples.
+         * The matching sub-chains are merged by the workers with list::merge
+         * and spliced back in order. Both lists are cut before the first value
+         * that does not go before the splitter, so equal values always land in
+         * the same sub-chain and the merge is stable: equal elements of l come
+         * before those of other.
+         *
+         * @param l the list that receives the result
+         * @param other the other list
+         * @param comp the comparison that sorts both lists
+         * @param n_workers how many threads to use (0 for one per core)
+         */
+        template < typename T, typename Compare, typename >
+        void merge( list<T> & l, list<T> & other, Compare comp, size_t n_workers ) {
+            if (&other == &l)
+                return;
+            if (n_workers == 0)
+                n_workers = default_workers();
+            if (n_workers <= 1 or l.empty() or other.empty()
+                or l.size() + other.size() < n_workers * min_merge_segment) {
+                l.merge(other, comp);
+                return;
+            }
+
+            using Node = typename list<T>::Node;
+            struct mark {
+                Node * node;
+                size_t pos; //!< Position of node in its list.
+            };
+
+            // Walk w samples half of list w / 2: the first half from the front, the
+            // second one from the back, so no walk is longer than half a list.
+            list<T> * lists[2] {&l, &other};
+            std::vector< mark > halves[4];
+            auto sample = [n_workers, &lists, &halves]( size_t w ) {
+                auto & from {*lists[w / 2]};
+                auto stride {std::max< size_t >(1, from.size() / (n_workers * merge_samples))};
+                auto half {from.size() / 2};
+                auto & marks {halves[w]};
+                marks.reserve(half / stride + 2);
+
+                auto forward {w % 2 == 0};
+                auto node {forward ? from.m_head->next : from.m_tail->prev};
+                auto pos {forward ? size_t{0} : from.size() - 1};
+                auto count {forward ? half : from.size() - half};
+                size_t skip {0};
+                for (size_t i {0}; i < count; i++, skip--) {
+                    if (skip == 0) {
+                        marks.push_back({node, pos});
+                        skip = stride;
+                    }
+                    node = forward ? node->next : node->prev;
+                    pos = forward ? pos + 1 : pos - 1;
+                }
+            };
+            run_segments(4, sample);
+
+            // Every list gets its marks in list order, the first node always included.
+            std::vector< mark > marks[2];
+            for (size_t k {0}; k < 2; k++) {
+                marks[k] = std::move(halves[2 * k]);
+                marks[k].insert(marks[k].end(), halves[2 * k + 1].rbegin(), halves[2 * k + 1].rend());
+            }
+
+            std::vector< const T * > samples;
+            samples.reserve(marks[0].size() + marks[1].size());
+            for (const auto & m : marks[0])
+                samples.push_back(&m.node->data);
+            for (const auto & m : marks[1])
+                samples.push_back(&m.node->data);
+            std::inplace_merge(samples.begin(), samples.begin() + marks[0].size(), samples.end(),
+                               [&comp]( const T * a, const T * b ) { return comp(*a, *b); });
+
+            auto n_parts {n_workers};
+            std::vector< const T * > splitters;
+            for (size_t i {1}; i < n_parts; i++)
+                splitters.push_back(samples[samples.size() * i / n_parts]);
+
+            // cuts[k][i] is the first node of list k that does not go before splitter i.
+            std::vector< mark > cuts[2] {std::vector< mark >(n_parts - 1), std::vector< mark >(n_parts - 1)};
+            auto find_cut = [&]( size_t task ) {
+                auto k {task / (n_parts - 1)};
+                auto i {task % (n_parts - 1)};
+                const auto & splitter {*splitters[i]};
+                // The sampled nodes are sorted: start from the last one that goes before the splitter.
+                auto after {std::partition_point(marks[k].begin(), marks[k].end(), [&]( const mark & m ) {
+                    return comp(m.node->data, splitter);
+                })};
+                if (after == marks[k].begin()) {
+                    cuts[k][i] = marks[k].front();
+                    return;
+                }
+                auto cut {*std::prev(after)};
+                while (cut.node != lists[k]->m_tail and comp(cut.node->data, splitter)) {
+                    cut.node = cut.node->next;
+                    cut.pos++;
+                }
+                cuts[k][i] = cut;
+            };
+            run_segments(2 * (n_parts - 1), find_cut);
+
+            std::vector< list<T> > parts[2] {std::vector< list<T> >(n_parts), std::vector< list<T> >(n_parts)};
+            for (size_t k {0}; k < 2; k++) {
+                auto & from {*lists[k]};
+                mark begin {from.m_head->next, 0};
+                auto end_pos {from.size()};
+                for (size_t i {0}; i < n_parts; i++) {
+                    auto end {i + 1 < n_parts ? cuts[k][i] : mark{from.m_tail, end_pos}};
+                    auto count {end.pos - begin.pos};
+                    if (count > 0) {
+                        auto last {end.node->prev};
+                        from.unlink_chain(begin.node, last, count);
+                        parts[k][i].link_chain(parts[k][i].m_tail, begin.node, last, count);
+                    }
+                    begin = end;
+                }
+            }
+
+            run_segments(n_parts, [&parts, &comp]( size_t i ) {
+                parts[0][i].merge(parts[1][i], comp);
+            });
+
+            for (auto & part : parts[0])
+                l.splice(l.cend(), part);
+        }
+    }
+}
+#endif
@@ -0,0 +1,379 @@
+#ifndef _RCU_LIST_H_
+#define _RCU_LIST_H_
+
+#include <atomic>    // atomic, atomic_thread_fence
+#include <cstddef>   // size_t, ptrdiff_t
+#include <iterator>  // forward_iterator_tag
+#include <mutex>     // mutex, lock_guard
+#include <stdexcept> // length_error, out_of_range
+
+#include "detail/cache_line.h"
+
+namespace sc {
+    /*!
+     * A doubly-linked list for read-mostly data, traversed concurrently by many
+     * readers while a writer inserts or erases.
+     *
+     * Readers register once (a `reader` object) and then enter a read-side
+     * critical section with enter(). Inside it they walk the list forward with
+     * cbegin()/cend() using only acquire loads: no lock and no atomic
+     * read-modify-write. The writer publishes every link change with a release
+     * store, and an erased node is only freed once no reader can still be
+     * standing on it, i.e. once every active reader entered after the node was
+     * unlinked (epoch-based reclamation).
+     *
+     * \note
+     * Readers may only move forward. Writer operations are serialised by an
+     * internal mutex, so the list still works with several writers; it is
+     * designed for one.
+     */
+    template < typename T >
+    class rcu_list {
+        public:
+            /// Maximum number of readers registered at the same time.
+            static constexpr std::size_t max_readers{ 64 };
+
+        private:
+            //=== the data node.
+            struct Node {
+                T data;
+                std::atomic< Node * > next; // Read by the readers.
+                Node * prev;                // Writer only.
+                std::size_t retired_at;     // Epoch in which the node was erased.
+                Node * next_retired;        // Chain of nodes waiting to be freed.
+
+                Node( const T &d=T{}, Node * n=nullptr, Node * p=nullptr )
+                    : data{d}, next{n}, prev{p}, retired_at{0}, next_retired{nullptr}
+                { /* empty */ }
+            };
+
+            /// Announces the epoch a reader is in, or zero when it is outside a critical section.
+            struct reader_slot {
+                std::atomic< std::size_t > epoch{ 0 };
+                std::atomic< bool > taken{ false };
+                char pad[ cache_line_size ]; // Keeps the epochs of two readers on different cache lines.
+            };
+
+        public:
+            class const_iterator {
+                //=== Some aliases to help writing a clearer code.
+                public:
+                    using value_type        = T;
+                    using pointer           = const T *;
+                    using reference         = const T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::forward_iterator_tag;
+
+                private:
+                    Node * m_ptr; //!< The raw pointer.
+
+                public:
+                    const_iterator( Node * ptr = nullptr ) : m_ptr {ptr} {}
+
+                    /**
+                     * @return a const reference to the value associated with the const_iterator
+                     */
+                    reference operator*() const {
+                        return m_ptr->data;
+                    }
+
+                    /**
+                     * @brief advances the const_iterator to the next value, following the link published by the writer
+                     *
+                     * @return const_iterator to the next value
+                     */
+                    const_iterator operator++() {
+                        if (m_ptr == nullptr)
+                            throw std::out_of_range("operator++(): iterator already in end of list");
+                        m_ptr = m_ptr->next.load(std::memory_order_acquire);
+                        return *this;
+                    }
+
+                    /**
+                     * @brief advances the const_iterator to the next value, following the link published by the writer
+                     *
+                     * @return const_iterator to the old value
+                     */
+                    const_iterator operator++(int) {
+                        if (m_ptr == nullptr)
+                            throw std::out_of_range("operator++(): iterator already in end of list");
+                        auto old {m_ptr};
+                        m_ptr = m_ptr->next.load(std::memory_order_acquire);
+                        return const_iterator{old};
+                    }
+
+                    bool operator==( const const_iterator & rhs ) const {
+                        return m_ptr == rhs.m_ptr;
+                    }
+
+                    bool operator!=( const const_iterator & rhs ) const {
+                        return m_ptr != rhs.m_ptr;
+                    }
+
+                    // We need friendship so the rcu_list<T> class may access the m_ptr field.
+                    friend class rcu_list<T>;
+            };
+
+            /*!
+             * A registered reader. Each reading thread owns one and brackets every
+             * traversal with enter(), which returns the guard of the critical section.
+             * Critical sections of the same reader may nest: only the outermost one
+             * announces and withdraws the reader's epoch.
+             */
+            class reader {
+                private:
+                    reader_slot * m_slot;
+                    std::size_t m_depth; // How many guards of this reader are alive.
+
+                public:
+                    /// Read-side critical section; nodes seen inside it stay alive until it ends.
+                    class guard {
+                        private:
+                            reader * m_reader;
+
+                        public:
+                            explicit guard( reader & r ) : m_reader{&r} {
+                                if (m_reader->m_depth++ != 0)
+                                    return;
+                                m_reader->m_slot->epoch.store(m_reader->m_list.m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+                                // Pairs with the fence in rcu_list::reclaim(): either the writer sees
+                                // this announcement, or this reader sees the writer's unlinks.
+                                std::atomic_thread_fence(std::memory_order_seq_cst);
+                            }
+
+                            guard( const guard & ) = delete;
+                            guard & operator=( const guard & ) = delete;
+                            guard( guard && other ) : m_reader{other.m_reader} { other.m_reader = nullptr; }
+
+                            ~guard() {
+                                if (m_reader != nullptr and --m_reader->m_depth == 0)
+                                    m_reader->m_slot->epoch.store(0, std::memory_order_release);
+                            }
+                    };
+
+                    /**
+                     * @brief Registers a new reader of l
+                     *
+                     * @param l the list that will be read
+                     */
+                    explicit reader( rcu_list & l ) : m_slot{nullptr}, m_depth{0}, m_list{l} {
+                        for (auto & slot : l.m_readers) {
+                            bool expected {false};
+                            if (slot.taken.compare_exchange_strong(expected, true)) {
+                                m_slot = &slot;
+                                return;
+                            }
+                        }
+                        throw std::length_error("reader(): too many readers registered on the list.");
+                    }
+
+                    reader( const reader & ) = delete;
+                    reader & operator=( const reader & ) = delete;
+
+                    ~reader() {
+                        m_slot->taken.store(false, std::memory_order_release);
+                    }
+
+                    /**
+                     * @brief Enters a read-side critical section
+                     *
+                     * @return the guard that leaves the critical section when destroyed
+                     */
+                    guard enter( void ) {
+                        return guard{*this};
+                    }
+
+                private:
+                    rcu_list & m_list;
+            };
+
+        //=== Private members.
+        private:
+            Node * m_head;                          // nó cabeça.
+            Node * m_tail;                          // nó calda.
+            std::size_t m_len;                      // comprimento da lista (writer only).
+            std::atomic< std::size_t > m_epoch;     // Current global epoch, starts at 1.
+            Node * m_retired_first;                 // Oldest erased node not freed yet.
+            Node * m_retired_last;                  // Newest erased node not freed yet.
+            std::mutex m_writer;                    // Serialises the writers.
+            reader_slot m_readers[ max_readers ];
+
+            /**
+             * @brief Links a new node holding value before pos
+             *
+             * @return the new node
+             */
+            Node * link_before( Node * pos, const T & value ) {
+                auto new_node {new Node{value, pos, pos->prev}};
+                // The node is complete before it becomes reachable.
+                pos->prev->next.store(new_node, std::memory_order_release);
+                pos->prev = new_node;
+                m_len++;
+                return new_node;
+            }
+
+            /**
+             * @brief Frees the erased nodes that no reader can reach anymore
+             */
+            void reclaim( void ) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // Smallest epoch announced by a reader still inside a critical section.
+                auto oldest {m_epoch.load(std::memory_order_relaxed)};
+                for (auto & slot : m_readers) {
+                    auto epoch {slot.epoch.load(std::memory_order_acquire)};
+                    if (epoch != 0 and epoch < oldest)
+                        oldest = epoch;
+                }
+
+                // Retired nodes are chained by increasing epoch.
+                while (m_retired_first != nullptr and m_retired_first->retired_at < oldest) {
+                    auto target {m_retired_first};
+                    m_retired_first = target->next_retired;
+                    delete target;
+                }
+                if (m_retired_first == nullptr)
+                    m_retired_last = nullptr;
+            }
+
+        public:
+            //=== [I] Special members
+            /**
+             * @brief Constructs an empty list
+             */
+            rcu_list() : m_head{new Node}, m_tail{new Node}, m_len{0}, m_epoch{1},
+                m_retired_first{nullptr}, m_retired_last{nullptr} {
+                m_head->next.store(m_tail, std::memory_order_relaxed);
+                m_tail->prev = m_head;
+            }
+
+            rcu_list( const rcu_list & ) = delete;
+            rcu_list & operator=( const rcu_list & ) = delete;
+
+            /**
+             * @brief Destroys the list. No reader may be inside a critical section.
+             */
+            ~rcu_list() {
+                auto curr {m_head};
+                while (curr != nullptr) {
+                    auto next {curr->next.load(std::memory_order_relaxed)};
+                    delete curr;
+                    curr = next;
+                }
+                while (m_retired_first != nullptr) {
+                    auto target {m_retired_first};
+                    m_retired_first = target->next_retired;
+                    delete target;
+                }
+            }
+
+            //=== [II] ITERATORS (readers, inside a critical section)
+            /**
+             * @return a const_iterator to the beggining of the list
+             */
+            const_iterator cbegin() const {
+                return const_iterator{m_head->next.load(std::memory_order_acquire)};
+            }
+
+            /**
+             * @return a const_iterator to the position after the end of the list
+             */
+            const_iterator cend() const {
+                return const_iterator{m_tail};
+            }
+
+            //=== [III] Capacity/Status (writer)
+            /**
+             * @return the size of the list
+             */
+            std::size_t size( void ) const {
+                return m_len;
+            }
+
+            /**
+             * @return wheter the list is empty
+             */
+            bool empty( void ) const {
+                return m_len == 0;
+            }
+
+            //=== [IV] Modifiers (writer)
+            /**
+             * @brief Add a value to the begin of the list
+             *
+             * @param value the value to be added
+             */
+            void push_front( const T & value ) {
+                std::lock_guard< std::mutex > lock{m_writer};
+                link_before(m_head->next.load(std::memory_order_relaxed), value);
+            }
+
+            /**
+             * @brief Add a value to the end of the list
+             *
+             * @param value the value to be added
+             */
+            void push_back( const T & value ) {
+                std::lock_guard< std::mutex > lock{m_writer};
+                link_before(m_tail, value);
+            }
+
+            /**
+             * @brief Inserts a new value in the list before pos
+             *
+             * @param pos the position before which the value is inserted
+             * @param value the value to be added
+             *
+             * @return a const_iterator to the new element
+             */
+            const_iterator insert( const_iterator pos, const T & value ) {
+                std::lock_guard< std::mutex > lock{m_writer};
+                return const_iterator{link_before(pos.m_ptr, value)};
+            }
+
+            /**
+             * @brief Unlinks the node at pos; its memory is freed once every reader that could see it has left
+             *
+             * @param pos the element to be removed
+             *
+             * @return a const_iterator to the element following the removed one
+             */
+            const_iterator erase( const_iterator pos ) {
+                std::lock_guard< std::mutex > lock{m_writer};
+                auto target {pos.m_ptr};
+                auto next {target->next.load(std::memory_order_relaxed)};
+
+                // The erased node keeps its own next link, so a reader standing on it can still move on.
+                target->prev->next.store(next, std::memory_order_release);
+                next->prev = target->prev;
+                m_len--;
+
+                target->retired_at = m_epoch.fetch_add(1);
+                if (m_retired_last == nullptr)
+                    m_retired_first = target;
+                else
+                    m_retired_last->next_retired = target;
+                m_retired_last = target;
+
+                reclaim();
+                return const_iterator{next};
+            }
+
+            /**
+             * @brief Erases every element of the list
+             */
+            void clear( void ) {
+                while (not empty())
+                    erase(cbegin());
+            }
+
+            /**
+             * @brief Frees the erased nodes that are no longer reachable by any reader
+             */
+            void synchronize( void ) {
+                std::lock_guard< std::mutex > lock{m_writer};
+                reclaim();
+            }
+    };
+}
+#endif
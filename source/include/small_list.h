@@ -0,0 +1,322 @@
+#ifndef _SMALL_LIST_H_
+#define _SMALL_LIST_H_
+
+#include <cstddef>          // size_t
+#include <functional>       // less, less_equal
+#include <initializer_list> // initializer_list
+#include <iterator>         // prev
+#include <new>              // placement new
+#include <stdexcept>        // out_of_range
+#include <type_traits>      // aligned_storage
+#include <utility>          // forward, move_if_noexcept
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * A doubly linked list that keeps its sentinels and its first N nodes
+     * inside the list object, like the small string optimisation.
+     *
+     * Nodes have the same layout as sc::list nodes and are linked the same
+     * way. A new node takes a free inline slot when there is one, and only
+     * goes to the heap when all N are in use, so a list that never holds more
+     * than N values never allocates.
+     *
+     * splice() and merge() relink heap nodes as they are, but an inline node
+     * belongs to the storage of its list: its value is moved into a node of
+     * the receiving list (inline if there is room, on the heap otherwise).
+     * Iterators to inline nodes of the other list are therefore invalidated.
+     */
+    template < typename T, size_t N >
+    class small_list {
+        static_assert(N > 0, "small_list needs room for at least one inline node.");
+
+        public:
+            using iterator       = typename list<T>::iterator;
+            using const_iterator = typename list<T>::const_iterator;
+
+        private:
+            using Node = typename list<T>::Node;
+            using slot = typename std::aligned_storage< sizeof(Node), alignof(Node) >::type;
+
+            slot m_slots[N];  //!< Inline node storage.
+            bool m_used[N];   //!< Which inline slots hold a node.
+            size_t m_len;
+            Node m_head;      //!< Sentinels, also kept inline.
+            Node m_tail;
+
+            //=== Node storage helpers.
+            /**
+             * @return whether node lives in the inline storage of this list
+             */
+            bool is_inline( const Node * node ) const {
+                const void * p {node};
+                return std::less_equal< const void * >{}(m_slots, p) and std::less< const void * >{}(p, m_slots + N);
+            }
+
+            /**
+             * @brief Builds a detached node holding value, in a free inline slot if there is one
+             */
+            template < typename U >
+            Node * create_node( U && value ) {
+                for (size_t i {0}; i < N; i++) {
+                    if (not m_used[i]) {
+                        auto node {new (&m_slots[i]) Node(std::forward<U>(value))};
+                        m_used[i] = true;
+                        return node;
+                    }
+                }
+                return new Node(std::forward<U>(value));
+            }
+
+            /**
+             * @brief Destroys a detached node and gives its memory back
+             */
+            void destroy_node( Node * node ) {
+                if (not is_inline(node)) {
+                    delete node;
+                    return;
+                }
+                auto i {size_t(reinterpret_cast< slot * >(node) - m_slots)};
+                node->~Node();
+                m_used[i] = false;
+            }
+
+            void link_before( Node * pos, Node * node ) {
+                node->prev       = pos->prev;
+                node->next       = pos;
+                pos->prev->next  = node;
+                pos->prev        = node;
+                m_len++;
+            }
+
+            void unlink( Node * node ) {
+                node->prev->next = node->next;
+                node->next->prev = node->prev;
+                m_len--;
+            }
+
+            /**
+             * @brief Takes node out of other and gives back a detached node of this list
+             * holding its value. Heap nodes are handed over as they are.
+             */
+            Node * adopt( Node * node, small_list & other ) {
+                if (not other.is_inline(node)) {
+                    other.unlink(node);
+                    return node;
+                }
+                auto moved {create_node(std::move_if_noexcept(node->data))};
+                other.unlink(node);
+                other.destroy_node(node);
+                return moved;
+            }
+
+        public:
+            //=== [I] Special members
+            small_list() : m_used{}, m_len{0}, m_head{}, m_tail{} {
+                m_head.next = &m_tail;
+                m_tail.prev = &m_head;
+            }
+
+            small_list( std::initializer_list<T> ilist ) : small_list() {
+                for (const auto & value : ilist)
+                    push_back(value);
+            }
+
+            small_list( const small_list & clone ) : small_list() {
+                for (const auto & value : clone)
+                    push_back(value);
+            }
+
+            /**
+             * @brief Takes the values of other. Heap nodes are relinked, inline ones moved.
+             */
+            small_list( small_list && other ) : small_list() {
+                splice(cend(), other);
+            }
+
+            small_list & operator=( const small_list & rhs ) {
+                if (this != &rhs) {
+                    clear();
+                    for (const auto & value : rhs)
+                        push_back(value);
+                }
+                return *this;
+            }
+
+            small_list & operator=( small_list && rhs ) {
+                if (this != &rhs) {
+                    clear();
+                    splice(cend(), rhs);
+                }
+                return *this;
+            }
+
+            ~small_list() {
+                clear();
+            }
+
+            //=== [II] ITERATORS
+            iterator begin() { return iterator{m_head.next}; }
+            iterator end() { return iterator{&m_tail}; }
+            const_iterator begin() const { return const_iterator{m_head.next}; }
+            const_iterator end() const { return const_iterator{const_cast< Node * >(&m_tail)}; }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            //=== [III] Capacity/Status
+            size_t size( void ) const { return m_len; }
+            bool empty( void ) const { return m_len == 0; }
+
+            /**
+             * @return how many nodes fit in the inline storage
+             */
+            static constexpr size_t inline_capacity( void ) { return N; }
+
+            /**
+             * @return the first value on the list
+             */
+            const T & front( void ) const {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return m_head.next->data;
+            }
+
+            /**
+             * @return the last value on the list
+             */
+            const T & back( void ) const {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return m_tail.prev->data;
+            }
+
+            //=== [IV] Modifiers
+            /**
+             * @brief Inserts a copy of value before pos
+             *
+             * @return an iterator to the new element
+             */
+            iterator insert( const_iterator pos, const T & value ) {
+                auto node {create_node(value)};
+                link_before(list<T>::node_of(pos), node);
+                return iterator{node};
+            }
+
+            void push_front( const T & value ) { insert(cbegin(), value); }
+            void push_back( const T & value ) { insert(cend(), value); }
+
+            /**
+             * @brief Removes the value at pos
+             *
+             * @return an iterator to the element that followed it
+             */
+            iterator erase( const_iterator pos ) {
+                auto node {list<T>::node_of(pos)};
+                auto next {node->next};
+                unlink(node);
+                destroy_node(node);
+                return iterator{next};
+            }
+
+            void pop_front() {
+                if (empty())
+                    throw std::out_of_range("pop_front(): cannot use the front method on an empty list.");
+                erase(cbegin());
+            }
+
+            void pop_back() {
+                if (empty())
+                    throw std::out_of_range("pop_back(): cannot use the back method on an empty list.");
+                erase(std::prev(cend()));
+            }
+
+            /**
+             * @brief Erases every value of the list
+             */
+            void clear( void ) {
+                while (not empty())
+                    erase(cbegin());
+            }
+
+            //=== [V] UTILITY METHODS
+            /**
+             * @brief Moves the values of other before pos. other becomes empty.
+             */
+            void splice( const_iterator pos, small_list & other ) {
+                if (&other == this)
+                    return;
+                auto at {list<T>::node_of(pos)};
+                while (not other.empty())
+                    link_before(at, adopt(other.m_head.next, other));
+            }
+
+            /**
+             * @brief Moves the value at it, in other, before pos
+             *
+             * @return an iterator to the moved element in this list
+             */
+            iterator splice( const_iterator pos, small_list & other, const_iterator it ) {
+                auto node {list<T>::node_of(it)};
+                auto at {list<T>::node_of(pos)};
+                if (&other == this) {
+                    if (node != at) {
+                        unlink(node);
+                        link_before(at, node);
+                    }
+                    return iterator{node};
+                }
+                auto moved {adopt(node, other)};
+                link_before(at, moved);
+                return iterator{moved};
+            }
+
+            /**
+             * @brief Merges the sorted list other into this sorted list. other becomes empty.
+             * Equal values of this list go first.
+             */
+            void merge( small_list & other ) {
+                merge(other, std::less<T>{});
+            }
+
+            /**
+             * @brief Merges other into this list, both sorted by comp. other becomes empty.
+             * Equal values of this list go first.
+             */
+            template < typename Compare >
+            void merge( small_list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+                auto curr {m_head.next};
+                while (not other.empty()) {
+                    auto first {other.m_head.next};
+                    while (curr != &m_tail and not comp(first->data, curr->data))
+                        curr = curr->next;
+                    link_before(curr, adopt(first, other));
+                }
+            }
+
+            /**
+             * @brief Reverses the list in place, relinking its nodes
+             */
+            void reverse( void ) {
+                if (m_len < 2)
+                    return;
+                auto curr {m_head.next};
+                while (curr != &m_tail) {
+                    auto old_next {curr->next};
+                    curr->next = curr->prev;
+                    curr->prev = old_next;
+                    curr = old_next;
+                }
+
+                // The sentinels stay put: swap the nodes they point to.
+                auto first {m_head.next};
+                m_head.next = m_tail.prev;
+                m_tail.prev = first;
+                m_head.next->prev = &m_head;
+                m_tail.prev->next = &m_tail;
+            }
+    };
+}
+#endif
@@ -0,0 +1,268 @@
+#ifndef _SORTED_LIST_H_
+#define _SORTED_LIST_H_
+
+#include <cstddef>          // size_t
+#include <functional>       // less
+#include <initializer_list> // initializer_list
+#include <stdexcept>        // out_of_range
+#include <utility>          // pair
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * A list that keeps its values sorted by Compare, built on sc::list nodes.
+     *
+     * insert() searches from a finger, the node inserted last, and from the
+     * nearer end of the list at the same time, after checking both ends. A
+     * stream of values that arrives nearly sorted therefore costs amortised
+     * O(1) per insert instead of a walk from the front, and a value far from
+     * the finger but close to an end is found from that end. Bulk inserts sort
+     * the batch and merge it in, in O(m log m + n).
+     *
+     * Values that compare equal keep their insertion order: a new value goes
+     * after the equal ones already in the list.
+     *
+     * \note
+     * Only const iterators are given out, since changing a value in place
+     * could break the order.
+     */
+    template < typename T, typename Compare = std::less<T> >
+    class sorted_list {
+        public:
+            using const_iterator = typename list<T>::const_iterator;
+
+        private:
+            using Node = typename list<T>::Node;
+
+            list<T> m_items;
+            Compare m_comp;
+            Node * m_finger; //!< Node inserted last, or nullptr.
+
+            /**
+             * @brief Finds the first node for which pred holds. pred must fail for a prefix
+             * of the list and hold for the rest.
+             *
+             * The ends are checked first. Then two walks take turns, one step
+             * each: one from the finger towards the answer, the other from the
+             * end of the list on the same side of the answer. The search stops as
+             * soon as either walk gets there, so it costs at most twice the
+             * distance from the answer to the nearer of the finger and that end.
+             *
+             * @return the first node for which pred holds, or the tail sentinel
+             */
+            template < typename Pred >
+            Node * first_where( Pred pred ) const {
+                auto head {m_items.m_head};
+                auto tail {m_items.m_tail};
+                if (m_items.empty() or not pred(tail->prev->data))
+                    return tail;
+                if (pred(head->next->data))
+                    return head->next;
+
+                // The answer lies strictly between the first and the last node. pred fails
+                // at low, which walks forward, and holds at high, which walks backward.
+                auto low {head->next};
+                auto high {tail->prev};
+                if (m_finger != nullptr) {
+                    if (pred(m_finger->data))
+                        high = m_finger;
+                    else
+                        low = m_finger;
+                }
+                while (true) {
+                    if (pred(low->next->data))
+                        return low->next;
+                    low = low->next;
+                    if (not pred(high->prev->data))
+                        return high;
+                    high = high->prev;
+                }
+            }
+
+        public:
+            //=== [I] Special members
+            /**
+             * @brief Constructs an empty list
+             *
+             * @param comp the comparison that sorts the list
+             */
+            explicit sorted_list( Compare comp = Compare{} ) : m_items{}, m_comp{comp}, m_finger{nullptr} {}
+
+            /**
+             * @brief Constructs a list holding the values of ilist, sorted
+             *
+             * @param ilist the values
+             * @param comp the comparison that sorts the list
+             */
+            sorted_list( std::initializer_list<T> ilist, Compare comp = Compare{} ) : sorted_list(comp) {
+                insert(ilist.begin(), ilist.end());
+            }
+
+            sorted_list( const sorted_list & other )
+                : m_items{other.m_items}, m_comp{other.m_comp}, m_finger{nullptr} {}
+
+            sorted_list & operator=( const sorted_list & rhs ) {
+                m_items = rhs.m_items;
+                m_comp = rhs.m_comp;
+                m_finger = nullptr;
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+            const_iterator begin() const { return m_items.cbegin(); }
+            const_iterator end() const { return m_items.cend(); }
+            const_iterator cbegin() const { return m_items.cbegin(); }
+            const_iterator cend() const { return m_items.cend(); }
+
+            //=== [III] Capacity/Status
+            /**
+             * @return the size of the list
+             */
+            size_t size( void ) const {
+                return m_items.size();
+            }
+
+            /**
+             * @return wheter the list is empty
+             */
+            bool empty( void ) const {
+                return m_items.empty();
+            }
+
+            /**
+             * @return the first (smallest) value of the list
+             */
+            const T & front( void ) const {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return m_items.m_head->next->data;
+            }
+
+            /**
+             * @return the last (greatest) value of the list
+             */
+            const T & back( void ) const {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return m_items.m_tail->prev->data;
+            }
+
+            //=== [IV] Modifiers
+            /**
+             * @brief Inserts value at its sorted position, after the values equal to it
+             *
+             * @param value the value to be added
+             *
+             * @return a const_iterator to the new element
+             */
+            const_iterator insert( const T & value ) {
+                auto pos {upper_bound(value)};
+                auto it {m_items.insert(typename list<T>::iterator{list<T>::node_of(pos)}, value)};
+                m_finger = list<T>::node_of(it);
+                return it;
+            }
+
+            /**
+             * @brief Inserts the values of [first, last). The batch is sorted apart and then merged in.
+             *
+             * @param first the beginning of the range
+             * @param last the position after the end of the range
+             */
+            template < typename InputIt >
+            void insert( InputIt first, InputIt last ) {
+                list<T> batch;
+                for (; first != last; ++first)
+                    batch.push_back(*first);
+                batch.sort(m_comp);
+                m_items.merge(batch, m_comp);
+                m_finger = nullptr;
+            }
+
+            /**
+             * @brief Inserts the values of ilist
+             */
+            void insert( std::initializer_list<T> ilist ) {
+                insert(ilist.begin(), ilist.end());
+            }
+
+            /**
+             * @brief Removes the value at pos
+             *
+             * @param pos the element to be removed
+             *
+             * @return a const_iterator to the element that followed it
+             */
+            const_iterator erase( const_iterator pos ) {
+                auto node {list<T>::node_of(pos)};
+                if (node == m_finger)
+                    m_finger = nullptr;
+                return m_items.erase(typename list<T>::iterator{node});
+            }
+
+            /**
+             * @brief Removes every value equivalent to key
+             *
+             * @return how many values were removed
+             */
+            size_t erase( const T & key ) {
+                auto range {equal_range(key)};
+                size_t count {0};
+                while (range.first != range.second) {
+                    range.first = erase(range.first);
+                    count++;
+                }
+                return count;
+            }
+
+            /**
+             * @brief Erases every value of the list
+             */
+            void clear( void ) {
+                m_items.clear();
+                m_finger = nullptr;
+            }
+
+            //=== [V] LOOKUP
+            /**
+             * @return a const_iterator to the first value that does not go before key
+             */
+            const_iterator lower_bound( const T & key ) const {
+                return const_iterator{first_where([this, &key]( const T & value ) { return not m_comp(value, key); })};
+            }
+
+            /**
+             * @return a const_iterator to the first value that goes after key
+             */
+            const_iterator upper_bound( const T & key ) const {
+                return const_iterator{first_where([this, &key]( const T & value ) { return m_comp(key, value); })};
+            }
+
+            /**
+             * @return the range of values equivalent to key
+             */
+            std::pair< const_iterator, const_iterator > equal_range( const T & key ) const {
+                auto first {lower_bound(key)};
+                auto last {first};
+                while (last != cend() and not m_comp(key, *last))
+                    ++last;
+                return {first, last};
+            }
+
+            /**
+             * @return whether a value equivalent to key is in the list
+             */
+            bool contains( const T & key ) const {
+                auto pos {lower_bound(key)};
+                return pos != cend() and not m_comp(key, *pos);
+            }
+
+            /**
+             * @return the list holding the values, in order
+             */
+            const list<T> & values( void ) const {
+                return m_items;
+            }
+    };
+}
+#endif
@@ -0,0 +1,139 @@
+#ifndef _SPSC_LIST_H_
+#define _SPSC_LIST_H_
+
+#include <atomic>    // atomic, memory_order
+#include <cstddef>   // size_t
+#include <utility>   // move
+
+#include "detail/cache_line.h"
+
+namespace sc {
+    /*!
+     * A singly-linked FIFO specialised for exactly one producer thread, calling
+     * push_back(), and exactly one consumer thread, calling pop_front().
+     *
+     * Neither side takes a lock nor performs an atomic read-modify-write. The
+     * producer publishes a node with a release store to the `next` link of the
+     * last node, and the consumer hands the node back with a release store to
+     * its head pointer. Consumed nodes are recycled by the producer, so a
+     * pipeline in steady state never calls the global allocator.
+     *
+     * \note
+     * Calling push_back() from more than one thread, or pop_front() from more
+     * than one thread, is undefined behaviour.
+     */
+    template < typename T >
+    class spsc_list {
+        private:
+            //=== the data node.
+            struct Node {
+                T data;
+                std::atomic< Node * > next;
+
+                Node() : data{}, next{nullptr}
+                { /* empty */ }
+            };
+
+            char m_pad_front[ cache_line_size ]; //!< Keeps m_head off the cache line of whatever comes before.
+
+            //=== Consumer side.
+            /// Last consumed node (a dummy node); the next value lives after it.
+            std::atomic< Node * > m_head;
+
+            char m_pad_middle[ cache_line_size ]; //!< Keeps the consumer and producer sides on different cache lines.
+
+            //=== Producer side.
+            Node * m_tail;      //!< Last produced node.
+            Node * m_first;     //!< Oldest node, either consumed or about to be recycled.
+            Node * m_head_copy; //!< Cached value of m_head, refreshed only when recycling stalls.
+
+            char m_pad_back[ cache_line_size ]; //!< Keeps the producer side off the cache line of whatever comes after.
+
+            /**
+             * @brief Gets a node for the producer, recycling one the consumer is done with when possible.
+             *
+             * @return a node owned by the producer
+             */
+            Node * acquire_node( void ) {
+                if (m_first != m_head_copy) {
+                    auto node {m_first};
+                    m_first = m_first->next.load(std::memory_order_relaxed);
+                    return node;
+                }
+
+                // Only now look at what the consumer has released.
+                m_head_copy = m_head.load(std::memory_order_acquire);
+                if (m_first != m_head_copy) {
+                    auto node {m_first};
+                    m_first = m_first->next.load(std::memory_order_relaxed);
+                    return node;
+                }
+
+                return new Node;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty list
+             */
+            spsc_list() : m_head{nullptr}, m_tail{new Node}, m_first{m_tail}, m_head_copy{m_tail} {
+                m_head.store(m_tail, std::memory_order_relaxed);
+            }
+
+            spsc_list( const spsc_list & ) = delete;
+            spsc_list & operator=( const spsc_list & ) = delete;
+
+            ~spsc_list() {
+                auto curr {m_first};
+                while (curr != nullptr) {
+                    auto next {curr->next.load(std::memory_order_relaxed)};
+                    delete curr;
+                    curr = next;
+                }
+            }
+
+            /**
+             * @brief Add a value to the end of the list. Must only be called by the producer.
+             *
+             * @param value the value to be added
+             */
+            void push_back( const T & value ) {
+                auto node {acquire_node()};
+                node->data = value;
+                node->next.store(nullptr, std::memory_order_relaxed);
+
+                // Publishes the value: the consumer acquires this link.
+                m_tail->next.store(node, std::memory_order_release);
+                m_tail = node;
+            }
+
+            /**
+             * @brief Removes the first value of the list. Must only be called by the consumer.
+             *
+             * @param value receives the removed value
+             *
+             * @return whether a value was removed, false when the list is empty
+             */
+            bool pop_front( T & value ) {
+                auto head {m_head.load(std::memory_order_relaxed)};
+                auto next {head->next.load(std::memory_order_acquire)};
+                if (next == nullptr)
+                    return false;
+
+                value = std::move(next->data);
+
+                // Hands the old dummy node back to the producer for recycling.
+                m_head.store(next, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @return wheter the list is empty. Only meaningful for the consumer.
+             */
+            bool empty( void ) const {
+                auto head {m_head.load(std::memory_order_relaxed)};
+                return head->next.load(std::memory_order_acquire) == nullptr;
+            }
+    };
+}
+#endif
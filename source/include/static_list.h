@@ -0,0 +1,483 @@
+#ifndef _STATIC_LIST_H_
+#define _STATIC_LIST_H_
+
+#include <cstddef>          // size_t, ptrdiff_t
+#include <functional>       // less, equal_to
+#include <initializer_list> // initializer_list
+#include <iterator>         // bidirectional_iterator_tag
+#include <stdexcept>        // length_error, out_of_range
+#include <utility>          // move, swap
+
+/// constexpr where the language allows a container to be used in constant expressions (C++20 on).
+#ifndef SC_CONSTEXPR20
+#   if __cplusplus >= 202002L
+#       define SC_CONSTEXPR20 constexpr
+#   else
+#       define SC_CONSTEXPR20
+#   endif
+#endif
+
+namespace sc {
+    /*!
+     * A doubly linked list of at most N values that never allocates.
+     *
+     * The nodes are an array inside the list object, linked by index rather
+     * than by pointer; the unused ones form a free list. Since links are
+     * indices, copying the list is a plain copy of the array. Everything is
+     * constexpr under C++20, so a list can be built at compile time.
+     *
+     * Operations that would go past N throw std::length_error, and
+     * try_push_front/try_push_back/try_insert report it by returning false
+     * instead. Splicing or merging from another static_list moves the values
+     * over, since each list owns its own array.
+     */
+    template < typename T, size_t N >
+    class static_list {
+        private:
+            struct slot {
+                T data;
+                size_t next;
+                size_t prev;
+            };
+
+            static constexpr size_t sentinel {N}; //!< Index of the sentinel, also the end of the free list.
+
+            slot m_nodes[N + 1];
+            size_t m_free; //!< First free node, chained through next.
+            size_t m_len;
+
+            SC_CONSTEXPR20 void link_before( size_t pos, size_t i ) {
+                m_nodes[i].prev = m_nodes[pos].prev;
+                m_nodes[i].next = pos;
+                m_nodes[m_nodes[pos].prev].next = i;
+                m_nodes[pos].prev = i;
+                m_len++;
+            }
+
+            SC_CONSTEXPR20 void unlink( size_t i ) {
+                m_nodes[m_nodes[i].prev].next = m_nodes[i].next;
+                m_nodes[m_nodes[i].next].prev = m_nodes[i].prev;
+                m_len--;
+            }
+
+            /**
+             * @brief Puts an unlinked node back on the free list, resetting its value
+             */
+            SC_CONSTEXPR20 void release( size_t i ) {
+                m_nodes[i].data = T{};
+                m_nodes[i].next = m_free;
+                m_free = i;
+            }
+
+            /**
+             * @brief Takes a free node holding value (m_free must not be the sentinel) and links it before pos
+             *
+             * @return the node index
+             */
+            template < typename U >
+            SC_CONSTEXPR20 size_t emplace_before( size_t pos, U && value ) {
+                auto i {m_free};
+                m_nodes[i].data = std::forward<U>(value); // If this throws, the node stays free.
+                m_free = m_nodes[i].next;
+                link_before(pos, i);
+                return i;
+            }
+
+            /**
+             * @brief Moves the value of node i of other before pos, and frees the node in other
+             */
+            SC_CONSTEXPR20 void take( size_t pos, static_list & other, size_t i ) {
+                emplace_before(pos, std::move(other.m_nodes[i].data));
+                other.unlink(i);
+                other.release(i);
+            }
+
+            SC_CONSTEXPR20 void require_room( size_t count, const char * message ) const {
+                if (count > N - m_len)
+                    throw std::length_error(message);
+            }
+
+            /**
+             * @brief Sorts the n nodes starting at first, following next. Stable.
+             *
+             * @return the first node of the sorted chain, which is linked through next and ends at the sentinel
+             */
+            template < typename Compare >
+            SC_CONSTEXPR20 size_t sort_chain( size_t first, size_t n, Compare & comp ) {
+                if (n == 1) {
+                    m_nodes[first].next = sentinel;
+                    return first;
+                }
+                auto mid {first};
+                for (size_t k {0}; k < n / 2; k++)
+                    mid = m_nodes[mid].next;
+                auto left {sort_chain(first, n / 2, comp)};
+                auto right {sort_chain(mid, n - n / 2, comp)};
+
+                size_t head {sentinel};
+                size_t tail {sentinel};
+                while (left != sentinel and right != sentinel) {
+                    size_t pick {left};
+                    if (comp(m_nodes[right].data, m_nodes[left].data)) {
+                        pick = right;
+                        right = m_nodes[right].next;
+                    } else
+                        left = m_nodes[left].next;
+                    if (tail == sentinel)
+                        head = pick;
+                    else
+                        m_nodes[tail].next = pick;
+                    tail = pick;
+                }
+                m_nodes[tail].next = left != sentinel ? left : right;
+                return head;
+            }
+
+        public:
+            class const_iterator;
+
+            class iterator {
+                public:
+                    using value_type        = T;
+                    using pointer           = T *;
+                    using reference         = T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                private:
+                    static_list * m_list;
+                    size_t m_index;
+
+                public:
+                    SC_CONSTEXPR20 iterator( static_list * l = nullptr, size_t index = 0 ) : m_list{l}, m_index{index} {}
+
+                    SC_CONSTEXPR20 reference operator*() const { return m_list->m_nodes[m_index].data; }
+                    SC_CONSTEXPR20 pointer operator->() const { return &m_list->m_nodes[m_index].data; }
+
+                    SC_CONSTEXPR20 iterator operator++() { m_index = m_list->m_nodes[m_index].next; return *this; }
+                    SC_CONSTEXPR20 iterator operator++(int) { auto old {*this}; ++*this; return old; }
+                    SC_CONSTEXPR20 iterator operator--() { m_index = m_list->m_nodes[m_index].prev; return *this; }
+                    SC_CONSTEXPR20 iterator operator--(int) { auto old {*this}; --*this; return old; }
+
+                    SC_CONSTEXPR20 bool operator==( const iterator & rhs ) const { return m_list == rhs.m_list and m_index == rhs.m_index; }
+                    SC_CONSTEXPR20 bool operator!=( const iterator & rhs ) const { return not (*this == rhs); }
+
+                    friend class static_list;
+                    friend class const_iterator;
+            };
+
+            class const_iterator {
+                public:
+                    using value_type        = T;
+                    using pointer           = const T *;
+                    using reference         = const T &;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                private:
+                    const static_list * m_list;
+                    size_t m_index;
+
+                public:
+                    SC_CONSTEXPR20 const_iterator( const static_list * l = nullptr, size_t index = 0 ) : m_list{l}, m_index{index} {}
+                    SC_CONSTEXPR20 const_iterator( const iterator & it ) : m_list{it.m_list}, m_index{it.m_index} {}
+
+                    SC_CONSTEXPR20 reference operator*() const { return m_list->m_nodes[m_index].data; }
+                    SC_CONSTEXPR20 pointer operator->() const { return &m_list->m_nodes[m_index].data; }
+
+                    SC_CONSTEXPR20 const_iterator operator++() { m_index = m_list->m_nodes[m_index].next; return *this; }
+                    SC_CONSTEXPR20 const_iterator operator++(int) { auto old {*this}; ++*this; return old; }
+                    SC_CONSTEXPR20 const_iterator operator--() { m_index = m_list->m_nodes[m_index].prev; return *this; }
+                    SC_CONSTEXPR20 const_iterator operator--(int) { auto old {*this}; --*this; return old; }
+
+                    SC_CONSTEXPR20 bool operator==( const const_iterator & rhs ) const { return m_list == rhs.m_list and m_index == rhs.m_index; }
+                    SC_CONSTEXPR20 bool operator!=( const const_iterator & rhs ) const { return not (*this == rhs); }
+
+                    friend class static_list;
+            };
+
+            //=== [I] Special members
+            SC_CONSTEXPR20 static_list() : m_nodes{}, m_free{0}, m_len{0} {
+                for (size_t i {0}; i < N; i++)
+                    m_nodes[i].next = i + 1;
+                m_nodes[sentinel].next = m_nodes[sentinel].prev = sentinel;
+            }
+
+            /**
+             * @brief Constructs a list holding the values of ilist
+             *
+             * @throw std::length_error if ilist holds more than N values
+             */
+            SC_CONSTEXPR20 static_list( std::initializer_list<T> ilist ) : static_list() {
+                require_room(ilist.size(), "static_list(): too many values for the capacity.");
+                for (const auto & value : ilist)
+                    emplace_before(sentinel, value);
+            }
+
+            // Links are indices into the array, so the implicit copy is already a deep copy.
+
+            //=== [II] ITERATORS
+            SC_CONSTEXPR20 iterator begin() { return iterator{this, m_nodes[sentinel].next}; }
+            SC_CONSTEXPR20 iterator end() { return iterator{this, sentinel}; }
+            SC_CONSTEXPR20 const_iterator begin() const { return const_iterator{this, m_nodes[sentinel].next}; }
+            SC_CONSTEXPR20 const_iterator end() const { return const_iterator{this, sentinel}; }
+            SC_CONSTEXPR20 const_iterator cbegin() const { return begin(); }
+            SC_CONSTEXPR20 const_iterator cend() const { return end(); }
+
+            //=== [III] Capacity/Status
+            SC_CONSTEXPR20 size_t size( void ) const { return m_len; }
+            SC_CONSTEXPR20 bool empty( void ) const { return m_len == 0; }
+            SC_CONSTEXPR20 bool full( void ) const { return m_len == N; }
+            static constexpr size_t capacity( void ) { return N; }
+
+            SC_CONSTEXPR20 T & front( void ) {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return m_nodes[m_nodes[sentinel].next].data;
+            }
+
+            SC_CONSTEXPR20 const T & front( void ) const {
+                if (empty())
+                    throw std::out_of_range("front(): cannot use the front method on an empty list.");
+                return m_nodes[m_nodes[sentinel].next].data;
+            }
+
+            SC_CONSTEXPR20 T & back( void ) {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return m_nodes[m_nodes[sentinel].prev].data;
+            }
+
+            SC_CONSTEXPR20 const T & back( void ) const {
+                if (empty())
+                    throw std::out_of_range("back(): cannot use the back method on an empty list.");
+                return m_nodes[m_nodes[sentinel].prev].data;
+            }
+
+            //=== [IV] Modifiers
+            /**
+             * @brief Inserts a copy of value before pos
+             *
+             * @return an iterator to the new element
+             * @throw std::length_error if the list is full
+             */
+            SC_CONSTEXPR20 iterator insert( const_iterator pos, const T & value ) {
+                require_room(1, "insert(): the list is full.");
+                return iterator{this, emplace_before(pos.m_index, value)};
+            }
+
+            /**
+             * @brief Inserts a copy of value before pos, if there is room
+             *
+             * @return whether the value was inserted
+             */
+            SC_CONSTEXPR20 bool try_insert( const_iterator pos, const T & value ) {
+                if (full())
+                    return false;
+                emplace_before(pos.m_index, value);
+                return true;
+            }
+
+            SC_CONSTEXPR20 void push_front( const T & value ) { insert(cbegin(), value); }
+            SC_CONSTEXPR20 void push_back( const T & value ) { insert(cend(), value); }
+            SC_CONSTEXPR20 bool try_push_front( const T & value ) { return try_insert(cbegin(), value); }
+            SC_CONSTEXPR20 bool try_push_back( const T & value ) { return try_insert(cend(), value); }
+
+            /**
+             * @brief Removes the value at pos
+             *
+             * @return an iterator to the element that followed it
+             */
+            SC_CONSTEXPR20 iterator erase( const_iterator pos ) {
+                auto i {pos.m_index};
+                auto next {m_nodes[i].next};
+                unlink(i);
+                release(i);
+                return iterator{this, next};
+            }
+
+            SC_CONSTEXPR20 void pop_front() {
+                if (empty())
+                    throw std::out_of_range("pop_front(): cannot use the front method on an empty list.");
+                erase(cbegin());
+            }
+
+            SC_CONSTEXPR20 void pop_back() {
+                if (empty())
+                    throw std::out_of_range("pop_back(): cannot use the back method on an empty list.");
+                erase(const_iterator{this, m_nodes[sentinel].prev});
+            }
+
+            /**
+             * @brief Erases every value of the list
+             */
+            SC_CONSTEXPR20 void clear( void ) {
+                while (not empty())
+                    erase(cbegin());
+            }
+
+            //=== [V] UTILITY METHODS
+            /**
+             * @brief Moves the values of other before pos. other becomes empty.
+             *
+             * @throw std::length_error if they do not fit; nothing is moved then
+             */
+            SC_CONSTEXPR20 void splice( const_iterator pos, static_list & other ) {
+                if (&other == this)
+                    return;
+                require_room(other.m_len, "splice(): the values do not fit in the list.");
+                while (not other.empty())
+                    take(pos.m_index, other, other.m_nodes[sentinel].next);
+            }
+
+            /**
+             * @brief Moves the value at it, in other, before pos
+             *
+             * @throw std::length_error if this list is full and other is another list
+             */
+            SC_CONSTEXPR20 void splice( const_iterator pos, static_list & other, const_iterator it ) {
+                if (&other == this) {
+                    if (it != pos) {
+                        unlink(it.m_index);
+                        link_before(pos.m_index, it.m_index);
+                    }
+                    return;
+                }
+                require_room(1, "splice(): the list is full.");
+                take(pos.m_index, other, it.m_index);
+            }
+
+            /**
+             * @brief Merges the sorted list other into this sorted list. other becomes empty.
+             */
+            SC_CONSTEXPR20 void merge( static_list & other ) {
+                merge(other, std::less<T>{});
+            }
+
+            /**
+             * @brief Merges other into this list, both sorted by comp. other becomes empty.
+             * Equal values of this list go first.
+             *
+             * @throw std::length_error if they do not fit; nothing is moved then
+             */
+            template < typename Compare >
+            SC_CONSTEXPR20 void merge( static_list & other, Compare comp ) {
+                if (&other == this)
+                    return;
+                require_room(other.m_len, "merge(): the values do not fit in the list.");
+                auto curr {m_nodes[sentinel].next};
+                while (not other.empty()) {
+                    auto first {other.m_nodes[sentinel].next};
+                    while (curr != sentinel and not comp(other.m_nodes[first].data, m_nodes[curr].data))
+                        curr = m_nodes[curr].next;
+                    take(curr, other, first);
+                }
+            }
+
+            /**
+             * @brief Sorts the list with a stable merge sort, relinking the nodes
+             */
+            SC_CONSTEXPR20 void sort( void ) {
+                sort(std::less<T>{});
+            }
+
+            /**
+             * @brief Sorts the list by comp with a stable merge sort, relinking the nodes
+             */
+            template < typename Compare >
+            SC_CONSTEXPR20 void sort( Compare comp ) {
+                if (m_len < 2)
+                    return;
+                auto first {sort_chain(m_nodes[sentinel].next, m_len, comp)};
+
+                // Rebuild the prev links of the sorted chain.
+                auto prev {sentinel};
+                for (auto i {first}; i != sentinel; i = m_nodes[i].next) {
+                    m_nodes[i].prev = prev;
+                    m_nodes[prev].next = i;
+                    prev = i;
+                }
+                m_nodes[prev].next = sentinel;
+                m_nodes[sentinel].prev = prev;
+            }
+
+            /**
+             * @brief Reverses the list, relinking the nodes
+             */
+            SC_CONSTEXPR20 void reverse( void ) {
+                auto i {sentinel};
+                do {
+                    std::swap(m_nodes[i].next, m_nodes[i].prev);
+                    i = m_nodes[i].prev;
+                } while (i != sentinel);
+            }
+
+            /**
+             * @brief Removes every value equal to the one before it
+             */
+            SC_CONSTEXPR20 void unique( void ) {
+                unique(std::equal_to<T>{});
+            }
+
+            /**
+             * @brief Removes every value for which pred holds with the one kept before it
+             */
+            template < typename BinaryPredicate >
+            SC_CONSTEXPR20 void unique( BinaryPredicate pred ) {
+                if (empty())
+                    return;
+                auto kept {m_nodes[sentinel].next};
+                while (m_nodes[kept].next != sentinel) {
+                    auto next {m_nodes[kept].next};
+                    if (pred(m_nodes[kept].data, m_nodes[next].data)) {
+                        unlink(next);
+                        release(next);
+                    } else
+                        kept = next;
+                }
+            }
+
+            /**
+             * @brief Removes every value equal to value
+             */
+            SC_CONSTEXPR20 void remove( const T & value ) {
+                remove_if([&value]( const T & e ) { return e == value; });
+            }
+
+            /**
+             * @brief Removes every value for which pred holds
+             */
+            template < typename UnaryPredicate >
+            SC_CONSTEXPR20 void remove_if( UnaryPredicate pred ) {
+                auto i {m_nodes[sentinel].next};
+                while (i != sentinel) {
+                    auto next {m_nodes[i].next};
+                    if (pred(m_nodes[i].data)) {
+                        unlink(i);
+                        release(i);
+                    }
+                    i = next;
+                }
+            }
+
+            //=== [VI] OPERATORS
+            friend SC_CONSTEXPR20 bool operator==( const static_list & l1, const static_list & l2 ) {
+                if (l1.size() != l2.size())
+                    return false;
+                for (auto i {l1.begin()}, j {l2.begin()}; i != l1.end(); ++i, ++j)
+                    if (not (*i == *j))
+                        return false;
+                return true;
+            }
+
+            friend SC_CONSTEXPR20 bool operator!=( const static_list & l1, const static_list & l2 ) {
+                return not (l1 == l2);
+            }
+    };
+
+#if __cplusplus < 201703L
+    template < typename T, size_t N >
+    constexpr size_t static_list< T, N >::sentinel;
+#endif
+}
+#endif
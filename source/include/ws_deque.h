@@ -0,0 +1,209 @@
+#ifndef _WS_DEQUE_H_
+#define _WS_DEQUE_H_
+
+#include <atomic>    // atomic, atomic_thread_fence
+#include <cstddef>   // size_t, ptrdiff_t
+#include <mutex>     // mutex, lock_guard
+#include <utility>   // move
+
+#include "list.h"
+#include "detail/cache_line.h"
+
+namespace sc {
+    /*!
+     * A work-stealing deque over sc::list nodes, meant for one per worker of a
+     * thread pool.
+     *
+     * The owner thread works at the back with push_back(), splice_back() and
+     * pop_back(). Any other thread may steal from the front, either one
+     * element with steal() or half of the elements with steal_half(), which
+     * cuts the front of the chain and relinks it into the thief's list in one
+     * go, the same way list::splice does.
+     *
+     * Owner and thieves follow the THE protocol: the owner publishes its back
+     * index, the thief its front index, and each checks the other's after a
+     * full fence. The owner only takes the lock when the deque is about to run
+     * dry and it might race with a thief for the same node; thieves always
+     * take it, which serialises them among themselves.
+     *
+     * \note
+     * A thief never takes the last element: it stays for the owner.
+     */
+    template < typename T >
+    class ws_deque {
+        private:
+            using Node = typename list<T>::Node;
+
+            /// Elements a steal must leave behind, so thieves never touch the owner's nodes.
+            static constexpr std::ptrdiff_t margin{ 1 };
+
+            list<T> m_items;                       //!< The nodes; its m_len is only fixed up on demand.
+            char m_pad_top[ cache_line_size ];     //!< Keeps m_top on its own cache line.
+            std::atomic< std::ptrdiff_t > m_top;    //!< Elements ever taken from the front.
+            char m_pad_bottom[ cache_line_size ];  //!< Keeps m_bottom on its own cache line.
+            std::atomic< std::ptrdiff_t > m_bottom; //!< Elements ever added minus popped at the back.
+            char m_pad_thieves[ cache_line_size ]; //!< Keeps the thieves' lock away from m_bottom.
+            std::mutex m_thieves;                  //!< Serialises thieves, and the owner when the deque runs dry.
+
+            /**
+             * @brief Moves the first count nodes, already reserved in m_top, to the end of out
+             */
+            void take_front( std::ptrdiff_t count, list<T> & out ) {
+                auto first {m_items.m_head->next};
+                auto last {first};
+                for (std::ptrdiff_t i {1}; i < count; i++)
+                    last = last->next;
+
+                // Same relinking as list::unlink_chain, without touching the owner's m_len.
+                m_items.m_head->next = last->next;
+                last->next->prev = m_items.m_head;
+                out.link_chain(out.m_tail, first, last, count);
+            }
+
+            /**
+             * @brief Reserves count elements at the front for a thief
+             *
+             * @return whether the owner is guaranteed to keep at least margin elements
+             */
+            bool reserve_front( std::ptrdiff_t count ) {
+                auto t {m_top.load(std::memory_order_relaxed)};
+                m_top.store(t + count, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (m_bottom.load(std::memory_order_acquire) - (t + count) >= margin)
+                    return true;
+
+                m_top.store(t, std::memory_order_relaxed);
+                return false;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty deque
+             */
+            ws_deque() : m_items{}, m_top{0}, m_bottom{0} {}
+
+            ws_deque( const ws_deque & ) = delete;
+            ws_deque & operator=( const ws_deque & ) = delete;
+
+            ~ws_deque() {
+                m_items.m_len = size();
+            }
+
+            /**
+             * @return how many elements are in the deque; exact only when no thread is using it
+             */
+            size_t size( void ) const {
+                auto count {m_bottom.load(std::memory_order_acquire) - m_top.load(std::memory_order_acquire)};
+                return count > 0 ? size_t(count) : 0;
+            }
+
+            /**
+             * @return wheter the deque is empty; exact only when no thread is using it
+             */
+            bool empty( void ) const {
+                return size() == 0;
+            }
+
+            //=== Owner side
+            /**
+             * @brief Add a value to the end of the deque. Owner only.
+             *
+             * @param value the value to be added
+             */
+            void push_back( const T & value ) {
+                auto b {m_bottom.load(std::memory_order_relaxed)};
+                m_items.insert(m_items.end(), value);
+                m_bottom.store(b + 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Moves every element of items to the end of the deque. Owner only.
+             *
+             * @param items the elements to be added; it becomes empty
+             */
+            void splice_back( list<T> & items ) {
+                if (items.empty())
+                    return;
+
+                auto b {m_bottom.load(std::memory_order_relaxed)};
+                auto count {items.m_len};
+                auto first {items.m_head->next};
+                auto last {items.m_tail->prev};
+                items.unlink_chain(first, last, count);
+                m_items.link_chain(m_items.m_tail, first, last, count);
+                m_bottom.store(b + std::ptrdiff_t(count), std::memory_order_release);
+            }
+
+            /**
+             * @brief Removes the last value of the deque. Owner only.
+             *
+             * @param value receives the removed value
+             *
+             * @return whether a value was removed, false when the deque is empty
+             */
+            bool pop_back( T & value ) {
+                auto b {m_bottom.load(std::memory_order_relaxed) - 1};
+                m_bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto t {m_top.load(std::memory_order_relaxed)};
+
+                if (b - t < margin) {
+                    // A thief may be going for the same node: settle it under the lock.
+                    m_bottom.store(b + 1, std::memory_order_relaxed);
+                    std::lock_guard< std::mutex > lock{m_thieves};
+                    t = m_top.load(std::memory_order_relaxed);
+                    if (b + 1 - t <= 0)
+                        return false;
+                    m_bottom.store(b, std::memory_order_relaxed);
+                }
+
+                auto last {m_items.m_tail->prev};
+                value = std::move(last->data);
+                m_items.erase(typename list<T>::iterator{last});
+                return true;
+            }
+
+            //=== Thief side
+            /**
+             * @brief Removes the first value of the deque. Any thread but the owner.
+             *
+             * @param value receives the removed value
+             *
+             * @return whether a value was stolen
+             */
+            bool steal( T & value ) {
+                list<T> stolen;
+                if (steal_half(stolen, 1) == 0)
+                    return false;
+
+                value = std::move(stolen.m_head->next->data);
+                return true;
+            }
+
+            /**
+             * @brief Moves the first half of the deque to the end of out. Any thread but the owner.
+             *
+             * @param out the thief's list that receives the elements
+             * @param limit the most elements to take (0 for no limit)
+             *
+             * @return how many elements were stolen
+             */
+            size_t steal_half( list<T> & out, size_t limit = 0 ) {
+                std::lock_guard< std::mutex > lock{m_thieves};
+
+                auto available {m_bottom.load(std::memory_order_acquire) - m_top.load(std::memory_order_relaxed)};
+                auto count {(available + 1) / 2};
+                if (limit != 0 and count > std::ptrdiff_t(limit))
+                    count = std::ptrdiff_t(limit);
+
+                // If the owner got in the way, try again for a single element.
+                if (count <= 0 or not (reserve_front(count) or (count > 1 and reserve_front(count = 1))))
+                    return 0;
+
+                take_front(count, out);
+                return size_t(count);
+            }
+    };
+}
+#endif
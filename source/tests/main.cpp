@@ -3,8 +3,27 @@
 #include <iterator>
 
 
+#include <thread>
+#include <random>
+#include <cctype>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <string>
+
 #include "include/tm/test_manager.h"
 #include "../include/list.h"
+#include "../include/spsc_list.h"
+#include "../include/rcu_list.h"
+#include "../include/chain_channel.h"
+#include "../include/ws_deque.h"
+#include "../include/par.h"
+#include "../include/lru_cache.h"
+#include "../include/sorted_list.h"
+#include "../include/hot_cold_list.h"
+#include "../include/small_list.h"
+#include "../include/intrusive_list.h"
+#include "../include/static_list.h"
 
 #define which_lib sc 
 // #define which_lib std
@@ -24,6 +43,38 @@ std::ostream & operator<<( std::ostream &os, const which_lib::list<T> & L )
     return os;
 }
 
+// A value with a payload: equal values can be told apart by their face,
+// which makes the stability of merges and sorts observable.
+struct Card{
+    int value; std::string face;
+    inline bool operator<( const Card &a ) const
+    { return value < a.value; }
+    inline bool operator==( const Card &a ) const
+    { return value == a.value and face == a.face; }
+    inline bool operator!=( const Card &a ) const
+    { return not ( *this == a ); }
+};
+
+// A value aligned beyond what operator new guarantees by default.
+struct alignas( 64 ) Wide{
+    int value;
+    inline bool operator==( const Wide &a ) const
+    { return value == a.value; }
+    inline bool operator!=( const Wide &a ) const
+    { return value != a.value; }
+};
+
+// Whether every value of l sits at an address aligned for its type.
+template < typename L >
+bool values_aligned( const L & l )
+{
+    using value_type = typename std::decay< decltype( *l.cbegin() ) >::type;
+    for ( auto it{ l.cbegin() } ; it != l.cend() ; ++it )
+        if ( reinterpret_cast< std::uintptr_t >( &*it ) % alignof( value_type ) != 0 )
+            return false;
+    return true;
+}
+
 int main( void )
 {
     //=== TESTING BASIC OPERATIONS METHODS
@@ -107,22 +158,24 @@ int main( void )
         for( auto e : list2 )
             EXPECT_EQ( e, i++ );
     }
-//#ifdef MOVE_SYNTAX_IMPLEMENTED
-
-    // // {
-    // //     BEGIN_TEST(tm, "Molistonstructor", "move the elements from another");
-    // //     // Range = the entire list.
-    // //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    // //     which_lib::list<int> list2( std::move( list ) );
+    {
+        BEGIN_TEST(tm, "MoveConstructor", "move the elements from another");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        auto first = list.begin();
+        which_lib::list<int> list2( std::move( list ) );
 
-    // //     EXPECT_EQ( list2.size(), 5 );
-    // //     // EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_TRUE( list.empty() );
+        // The nodes themselves were moved.
+        EXPECT_TRUE(( first == list2.begin() ));
 
-    // //     // CHeck whether the copy worked.
-    // //     for( auto i{0u} ; i < list2.size() ; ++i )
-    // //         EXPECT_EQ( i+1, list2[i] );
-    // // }
-//#endif
+        // CHeck whether the move worked.
+        auto i{1};
+        for( auto e : list2 )
+            EXPECT_EQ( e, i++ );
+    }
 
 
     {
@@ -141,25 +194,23 @@ int main( void )
             EXPECT_EQ ( e,i++ );;
     }
 
-//#ifdef MOVE_SYNTAX_IMPLEMENTED  
-    // // // {
-    // // //     BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
-    // // //     // Range = the entire list.
-    // // //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    // // //     which_lib::list<int> list2;
-
-    // // //     list2 = std::move( list );
-    // // //     EXPECT_EQ( list2.size(), 5 );
-    // // //     EXPECT_FALSE( list2.empty() );
-    // // //     EXPECT_EQ( list.size(), 0 );
-    // // //     EXPECT_EQ( list.capacity(), 0 );
-    // // //     EXPECT_TRUE( list.empty() );
-
-    // // //     // CHeck whether the copy worked.
-    // // //     for( auto i{0u} ; i < list2.size() ; ++i )
-    // // //         EXPECT_EQ( i+1, list2[i] );
-    // // // }
-//#endif
+    {
+        BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        which_lib::list<int> list2{ 10, 20 };
+
+        list2 = std::move( list );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list.size(), 0 );
+        EXPECT_TRUE( list.empty() );
+
+        // CHeck whether the move worked.
+        auto i{1};
+        for( auto e : list2 )
+            EXPECT_EQ( e, i++ );
+    }
 
 
     {
@@ -816,6 +867,59 @@ int main( void )
         EXPECT_TRUE( list_b.empty() ); // List B must be empty (all nodes moved to A).
     }
 
+    {
+        BEGIN_TEST(tm3, "Merge 7","merging with a comparator.");
+        which_lib::list<int> list_a{ 9, 7, 5, 3, 1 };        // List A
+        which_lib::list<int> list_b{ 10, 8, 6, 4, 2, 0 };    // List B
+        which_lib::list<int> list_r{ 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }; // List Result
+
+        list_a.merge( list_b, std::greater<int>() ); // Merger B into A.
+        EXPECT_EQ( list_r, list_a ); // List A must be equal to list Result.
+        EXPECT_TRUE( list_b.empty() ); // List B must be empty (all nodes moved to A).
+        EXPECT_EQ( list_a.size(), 11 );
+    }
+    {
+        BEGIN_TEST(tm3, "Merge 8","merging a small list into a large one gallops.");
+        which_lib::list<int> list_a;
+        which_lib::list<int> list_b{ 1, 20001, 40001, 60001, 80001 };
+        which_lib::list<int> list_r;
+        for ( int i{0} ; i < 100000 ; ++i )
+        {
+            list_a.push_back( 2 * i );
+            list_r.push_back( 2 * i );
+            if ( i % 10000 == 0 and i < 50000 )
+                list_r.push_back( 2 * i + 1 );
+        }
+
+        size_t n_comparisons{ 0 };
+        list_a.merge( list_b, [&n_comparisons]( int a, int b ){ ++n_comparisons; return a < b; } );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_TRUE( list_b.empty() );
+        // A linear merge would need about 100000 comparisons.
+        EXPECT_LT( n_comparisons, 1000 );
+    }
+    {
+        BEGIN_TEST(tm3, "Merge 9","galloping keeps the merge stable.");
+        which_lib::list<Card> list_a;
+        which_lib::list<Card> list_b;
+        for ( int i{0} ; i < 1000 ; ++i )
+        {
+            list_a.push_back( { i / 50, "a" } );
+            list_b.push_back( { i / 30, "b" } );
+        }
+
+        list_a.merge( list_b );
+        bool stable{ list_a.size() == 2000 };
+        Card prev{ -1, "a" };
+        for ( const auto & e : list_a )
+        {
+            if ( e.value < prev.value or ( e.value == prev.value and e.face < prev.face ) )
+                stable = false;
+            prev = e;
+        }
+        EXPECT_TRUE( stable );
+    }
+
     {
         BEGIN_TEST(tm3, "Splice 1","splicing at the beginning.");
         which_lib::list<int> list_a{ 1, 2, 3, 4, 5 };              // List B
@@ -890,6 +994,490 @@ int main( void )
         }
     }
 
+    {
+        BEGIN_TEST(tm3, "SetAlgebra 1", "union, intersection and differences of small sorted lists.");
+        which_lib::list<int> list_b{ 2, 3, 3, 6, 8 };
+
+        which_lib::list<int> list_a{ 1, 3, 3, 3, 5, 8 };
+        auto two = list_b.begin();
+        list_a.set_union( list_b );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 2, 3, 3, 3, 5, 6, 8 } ) );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_TRUE(( two == std::next( list_a.begin() ) )); // moved, not copied.
+
+        list_b = { 2, 3, 3, 6, 8 };
+        list_a = { 1, 3, 3, 3, 5, 8 };
+        list_a.set_intersection( list_b );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 3, 3, 8 } ) );
+        EXPECT_EQ( list_b.size(), 5 );
+
+        list_a = { 1, 3, 3, 3, 5, 8 };
+        list_a.set_difference( list_b );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 3, 5 } ) );
+
+        list_a = { 1, 3, 3, 3, 5, 8 };
+        list_a.set_symmetric_difference( list_b );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 2, 3, 5, 6 } ) );
+        EXPECT_TRUE( list_b.empty() );
+
+        list_a = { 9, 7, 7, 1 };
+        list_b = { 8, 7, 2 };
+        list_a.set_union( list_b, []( int a, int b ){ return a > b; } );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 9, 8, 7, 7, 2, 1 } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "SetAlgebra 2", "agrees with <algorithm> on random multisets.");
+        std::mt19937 gen{ 41 };
+        std::uniform_int_distribution< int > value{ 0, 60 };
+        bool same{ true };
+        for ( int round{0} ; round < 50 ; ++round ) {
+            std::vector< int > a( round * 3 ), b( 150 - round * 3 );
+            for ( auto & e : a ) e = value( gen );
+            for ( auto & e : b ) e = value( gen );
+            std::sort( a.begin(), a.end() );
+            std::sort( b.begin(), b.end() );
+
+            std::vector< int > r_union, r_inter, r_diff, r_sym;
+            std::set_union( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( r_union ) );
+            std::set_intersection( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( r_inter ) );
+            std::set_difference( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( r_diff ) );
+            std::set_symmetric_difference( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( r_sym ) );
+
+            which_lib::list<int> list_b( b.begin(), b.end() );
+            which_lib::list<int> list_a( a.begin(), a.end() );
+            list_a.set_intersection( list_b );
+            same = same and list_a == which_lib::list<int>( r_inter.begin(), r_inter.end() );
+
+            list_a.assign( a.begin(), a.end() );
+            list_a.set_difference( list_b );
+            same = same and list_a == which_lib::list<int>( r_diff.begin(), r_diff.end() );
+
+            list_a.assign( a.begin(), a.end() );
+            list_a.set_union( list_b );
+            same = same and list_a == which_lib::list<int>( r_union.begin(), r_union.end() );
+
+            list_a.assign( a.begin(), a.end() );
+            list_b.assign( b.begin(), b.end() );
+            list_a.set_symmetric_difference( list_b );
+            same = same and list_a == which_lib::list<int>( r_sym.begin(), r_sym.end() );
+            same = same and list_a.size() == r_sym.size();
+        }
+        EXPECT_TRUE( same );
+    }
+
+    {
+        BEGIN_TEST(tm3, "ForEachPrefetch 1", "visits every element in order, whatever the distance.");
+        // Nodes scattered by a random insert and erase history.
+        which_lib::list<int> list_a;
+        std::mt19937 gen{ 42 };
+        for ( int i{0} ; i < 5000 ; ++i ) {
+            std::uniform_int_distribution< size_t > pos{ 0, list_a.size() };
+            list_a.insert( std::next( list_a.begin(), pos( gen ) ), i );
+            if ( i % 3 == 0 )
+                list_a.erase( std::next( list_a.begin(), pos( gen ) % list_a.size() ) );
+        }
+        std::vector< int > expected( list_a.begin(), list_a.end() );
+
+        for ( size_t distance : { size_t(0), size_t(1), size_t(8), size_t(100000) } ) {
+            std::vector< int > seen;
+            sc::for_each_prefetch( list_a, [&seen]( int & e ){ seen.push_back( e ); }, distance );
+            EXPECT_EQ( seen, expected );
+        }
+
+        sc::for_each_prefetch( list_a, []( int & e ){ e *= 2; } );
+        const which_lib::list<int> & view = list_a;
+        long long sum{ 0 };
+        sc::for_each_prefetch( view, [&sum]( const int & e ){ sum += e; } );
+        EXPECT_EQ( sum, 2 * std::accumulate( expected.begin(), expected.end(), 0LL ) );
+
+        which_lib::list<int> list_b( list_a );
+        EXPECT_EQ( list_a, list_b );
+        list_b.pop_back();
+        list_b.push_back( -1 );
+        EXPECT_TRUE(( list_a != list_b ));
+    }
+
+    {
+        BEGIN_TEST(tm3, "Compact 1", "compact() lays the nodes out in traversal order.");
+        which_lib::list<std::string> list_a;
+        std::mt19937 gen{ 43 };
+        for ( int i{0} ; i < 3000 ; ++i ) {
+            std::uniform_int_distribution< size_t > pos{ 0, list_a.size() };
+            list_a.insert( std::next( list_a.begin(), pos( gen ) ), std::to_string( i ) );
+            if ( i % 4 == 0 )
+                list_a.erase( std::next( list_a.begin(), pos( gen ) % list_a.size() ) );
+        }
+        std::vector< std::string > expected( list_a.begin(), list_a.end() );
+
+        EXPECT_EQ( list_a.compact(), list_a.size() );
+        EXPECT_EQ( list_a.compact(), 0u );
+        EXPECT_TRUE( std::equal( expected.begin(), expected.end(), list_a.begin() ) );
+
+        // Consecutive values now sit at a constant stride in memory.
+        auto address = []( const std::string & e ){ return reinterpret_cast< std::uintptr_t >( &e ); };
+        auto stride = address( *std::next( list_a.begin() ) ) - address( *list_a.begin() );
+        bool contiguous{ true };
+        for ( auto it = list_a.begin() ; std::next( it ) != list_a.end() ; ++it )
+            if ( address( *std::next( it ) ) - address( *it ) != stride )
+                contiguous = false;
+        EXPECT_TRUE( contiguous );
+    }
+    {
+        BEGIN_TEST(tm3, "Compact 2", "compacting in small steps, with changes in between.");
+        which_lib::list<int> list_a;
+        for ( int i{0} ; i < 1000 ; ++i )
+            list_a.insert( i % 2 == 0 ? list_a.end() : list_a.begin(), i );
+
+        size_t steps{ 0 };
+        while ( list_a.compact( 64 ) != 0 ) {
+            if ( ++steps == 3 ) {
+                list_a.erase( std::next( list_a.begin(), 10 ) ); // a hole in the compacted part.
+                list_a.push_front( -1 );
+            }
+        }
+        EXPECT_TRUE(( steps > 1000 / 64 ));
+        EXPECT_EQ( list_a.compact(), 0u );
+        EXPECT_EQ( list_a.size(), 1000u );
+        EXPECT_EQ( list_a.front(), -1 );
+
+        // Nodes of one block may outlive the list that compacted them.
+        which_lib::list<int> list_b;
+        {
+            which_lib::list<int> list_c{ 1, 2, 3, 4, 5 };
+            list_c.compact();
+            list_b.splice( list_b.cend(), list_c, std::next( list_c.cbegin() ), std::prev( list_c.cend() ) );
+        }
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 2, 3, 4 } ) );
+
+        // Blocks keep over-aligned values aligned.
+        which_lib::list<Wide> list_d;
+        for ( int i{0} ; i < 100 ; ++i )
+            list_d.push_back( { i } );
+        list_d.compact( 30 );
+        list_d.compact();
+        EXPECT_TRUE( values_aligned( list_d ) );
+        EXPECT_EQ( list_d.back().value, 99 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "Reserve 1", "in no-alloc mode only the reserved nodes are used, and they are reused.");
+        sc::list<int> list_a;
+        list_a.reserve( 6 );
+        EXPECT_EQ( list_a.capacity(), 6 );
+        list_a.set_no_alloc( true );
+
+        std::vector< const int * > reserved;
+        for ( int i{0} ; i < 6 ; ++i ) {
+            EXPECT_TRUE( list_a.try_push_back( i ) );
+            reserved.push_back( &*std::prev( list_a.end() ) );
+        }
+        EXPECT_FALSE( list_a.try_push_front( 6 ) );
+        EXPECT_TRUE(( list_a.try_insert( list_a.begin(), 6 ) == list_a.end() ));
+
+        bool worked{ false };
+        try {
+            list_a.push_back( 6 );
+        } catch ( const std::length_error & ) {
+            worked = true;
+        }
+        EXPECT_TRUE( worked );
+        EXPECT_EQ( list_a.size(), 6 );
+
+        // Erased nodes go back to the pool and are handed out again.
+        list_a.pop_front();
+        list_a.remove_if( []( int v ){ return v % 2 == 0; } );
+        EXPECT_EQ( list_a, ( sc::list<int>{ 1, 3, 5 } ) );
+        EXPECT_EQ( list_a.capacity(), 6 );
+        for ( int i{0} ; i < 3 ; ++i ) {
+            EXPECT_TRUE( list_a.try_push_front( 10 + i ) );
+            EXPECT_TRUE(( std::find( reserved.begin(), reserved.end(), &*list_a.begin() ) != reserved.end() ));
+        }
+        EXPECT_EQ( list_a, ( sc::list<int>{ 12, 11, 10, 1, 3, 5 } ) );
+        list_a.clear();
+        EXPECT_EQ( list_a.capacity(), 6 );
+    }
+    {
+        BEGIN_TEST(tm3, "Reserve 2", "emplace, try_emplace and shrink_to_fit.");
+        sc::list< std::pair< int, std::string > > list_a;
+        list_a.emplace_back( 2, "two" );
+        list_a.emplace_front( 1, "one" );
+        list_a.emplace( std::next( list_a.begin() ), 3, "three" );
+        EXPECT_EQ( list_a.size(), 3 );
+        EXPECT_EQ( list_a.capacity(), 3 );
+        EXPECT_EQ( ( *std::next( list_a.begin() ) ).second, "three" );
+
+        list_a.reserve( 4 );
+        list_a.set_no_alloc( true );
+        EXPECT_TRUE( list_a.no_alloc() );
+        EXPECT_TRUE(( list_a.try_emplace( list_a.end(), 4, "four" ) != list_a.end() ));
+        EXPECT_TRUE(( list_a.try_emplace( list_a.end(), 5, "five" ) == list_a.end() ));
+        EXPECT_EQ( list_a.back().second, "four" );
+
+        list_a.erase( list_a.begin() );
+        EXPECT_EQ( list_a.capacity(), 4 );
+        list_a.shrink_to_fit();
+        EXPECT_EQ( list_a.capacity(), 3 );
+        EXPECT_TRUE(( list_a.try_emplace( list_a.end(), 5, "five" ) == list_a.end() ));
+
+        list_a.set_no_alloc( false );
+        list_a.emplace_back( 5, "five" );
+        EXPECT_EQ( list_a.size(), 4 );
+    }
+    {
+        BEGIN_TEST(tm3, "NodeCache 1", "destroyed nodes are cached per thread and reused by other lists.");
+        using List = sc::list<int>;
+        List::set_node_cache_limit( 4 );
+        std::vector< const int * > freed;
+        {
+            List list_a{ 1, 2, 3 };
+            for ( const auto & v : list_a )
+                freed.push_back( &v );
+            EXPECT_EQ( List::node_cache_size(), 0 );
+        }
+        // Three element nodes and two sentinels, but the cache keeps at most 4.
+        EXPECT_EQ( List::node_cache_size(), 4 );
+        {
+            List list_b{ 7 };
+            EXPECT_EQ( List::node_cache_size(), 1 );
+            list_b.push_back( 8 );
+            EXPECT_EQ( List::node_cache_size(), 0 );
+            EXPECT_TRUE(( std::find( freed.begin(), freed.end(), &*list_b.begin() ) != freed.end() ));
+            list_b.pop_back();
+            EXPECT_EQ( List::node_cache_size(), 1 );
+        }
+        EXPECT_EQ( List::node_cache_size(), 4 );
+        List::trim_node_cache( 1 );
+        EXPECT_EQ( List::node_cache_size(), 1 );
+        List::set_node_cache_limit( 0 );
+        EXPECT_EQ( List::node_cache_size(), 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "NodeCache 2", "lists built on one thread can be destroyed on another.");
+        using List = sc::list< std::string >;
+        List::set_node_cache_limit( 64 );
+        std::vector< List > built( 8 );
+        std::thread producer( [&built]{
+            List::set_node_cache_limit( 16 );
+            for ( size_t i{0} ; i < built.size() ; ++i ) {
+                List scratch;
+                for ( size_t j{0} ; j < 10 ; ++j )
+                    scratch.push_back( std::to_string( i * 10 + j ) );
+                built[i] = List{ scratch };
+            }
+            // The cache is emptied when the thread ends.
+        } );
+        producer.join();
+
+        size_t total{0};
+        for ( auto & l : built ) {
+            total += l.size();
+            l.clear();
+        }
+        EXPECT_EQ( total, 80 );
+        EXPECT_EQ( List::node_cache_size(), 64 );
+        List reused{ "a", "b" };
+        EXPECT_EQ( List::node_cache_size(), 60 );
+        List::set_node_cache_limit( 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "NodeCache 3", "over-aligned nodes stay aligned, and no-alloc lists skip the cache.");
+        struct Narrow { char bytes[ 104 ]; }; // Same node size as Wide, default alignment.
+        using WideList = sc::list< Wide >;
+        using NarrowList = sc::list< Narrow >;
+        WideList::set_node_cache_limit( 16 );
+        NarrowList::set_node_cache_limit( 16 );
+        {
+            NarrowList narrow;
+            for ( int i{0} ; i < 8 ; ++i )
+                narrow.push_back( Narrow{} );
+        }
+        EXPECT_EQ( NarrowList::node_cache_size(), 10 );
+
+        bool aligned{ true };
+        for ( int round{0} ; round < 2 ; ++round ) { // The second round reuses cached nodes.
+            WideList list_a;
+            list_a.reserve( 4 );
+            for ( int i{0} ; i < 12 ; ++i )
+                list_a.push_back( { i } );
+            list_a.erase( std::next( list_a.begin(), 3 ) );
+            list_a.push_front( { -1 } );
+            WideList list_b{ list_a };
+            aligned = aligned and values_aligned( list_a ) and values_aligned( list_b ) and list_a == list_b;
+        }
+        EXPECT_TRUE( aligned );
+        // Wide nodes never came from, nor went to, the cache of Narrow nodes.
+        EXPECT_EQ( NarrowList::node_cache_size(), 10 );
+
+        // In no-alloc mode only the reserved nodes are used, even with a full cache.
+        EXPECT_TRUE(( WideList::node_cache_size() > 0 ));
+        auto cached = WideList::node_cache_size();
+        WideList list_c;
+        list_c.reserve( 2 );
+        list_c.set_no_alloc( true );
+        EXPECT_TRUE( list_c.try_push_back( { 1 } ) );
+        EXPECT_TRUE( list_c.try_push_back( { 2 } ) );
+        EXPECT_FALSE( list_c.try_push_back( { 3 } ) );
+        EXPECT_EQ( list_c.size(), 2 );
+        EXPECT_EQ( WideList::node_cache_size(), cached - 2 ); // Only the sentinels came from the cache.
+
+        WideList::set_node_cache_limit( 0 );
+        NarrowList::set_node_cache_limit( 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "Trivial 1", "copies of compacted trivially copyable lists are laid out in one block.");
+        sc::list<int> list_a;
+        for ( int i{0} ; i < 40 ; ++i )
+            list_a.push_back( i );
+        list_a.compact( 15 );                 // Mixed layout: a block run, then scattered nodes.
+        list_a.splice( list_a.begin(), list_a, std::prev( list_a.end() ) );
+
+        auto list_c = list_a;                 // Not fully compacted: copied node by node.
+        EXPECT_EQ( list_a, list_c );
+        EXPECT_EQ( list_c.compact(), 40 );
+
+        list_a.compact();
+        auto list_b = list_a;
+        EXPECT_EQ( list_a, list_b );
+        EXPECT_EQ( list_b.compact(), 0 );     // Nothing left to lay out.
+        const int * prev = nullptr;
+        bool contiguous{ true };
+        for ( const auto & v : list_b ) {
+            if ( prev != nullptr and reinterpret_cast< const char * >( &v ) <= reinterpret_cast< const char * >( prev ) )
+                contiguous = false;
+            prev = &v;
+        }
+        EXPECT_TRUE( contiguous );
+
+        // The copy is independent of the original.
+        *std::next( list_b.begin(), 20 ) = -1;
+        EXPECT_NE( list_a, list_b );
+        list_b.erase( std::next( list_b.begin(), 3 ), std::next( list_b.begin(), 30 ) );
+        EXPECT_EQ( list_b.size(), 13 );
+        list_b.push_back( 99 );
+        EXPECT_EQ( list_b.back(), 99 );
+        EXPECT_EQ( list_a.size(), 40 );
+        EXPECT_EQ( list_a.front(), 39 );
+    }
+    {
+        BEGIN_TEST(tm3, "Trivial 2", "comparing and clearing lists with mixed layouts.");
+        sc::list<int> list_a, list_b;
+        for ( int i{0} ; i < 100 ; ++i ) {
+            list_a.push_back( i );
+            list_b.push_back( i );
+        }
+        list_a.compact();
+        list_b.compact( 50 );
+        EXPECT_EQ( list_a, list_b );
+
+        *std::next( list_b.begin(), 30 ) = 0;
+        EXPECT_NE( list_a, list_b );
+        *std::next( list_b.begin(), 30 ) = 30;
+        *std::prev( list_a.end() ) = 0;
+        EXPECT_NE( list_a, list_b );
+
+        // Nodes of one block spread over two lists: the block goes with the last of them.
+        sc::list<int> list_c;
+        list_c.splice( list_c.begin(), list_a, std::next( list_a.begin(), 10 ), std::next( list_a.begin(), 20 ) );
+        list_a.clear();
+        EXPECT_EQ( list_c.size(), 10 );
+        EXPECT_EQ( list_c.front(), 10 );
+        EXPECT_EQ( list_c, sc::list<int>( list_c ) );
+
+        sc::list<double> list_d{ 0.0, 1.5 }, list_e{ -0.0, 1.5 };
+        list_d.compact();
+        list_e.compact();
+        EXPECT_EQ( list_d, list_e );          // Compared with ==, not by bytes.
+
+        // A trivially copyable type with an equality of its own.
+        struct CI {
+            char c;
+            bool operator==( const CI & o ) const { return std::tolower( c ) == std::tolower( o.c ); }
+            bool operator!=( const CI & o ) const { return not ( *this == o ); }
+        };
+        sc::list<CI> list_f{ { 'a' }, { 'B' }, { 'c' } }, list_g{ { 'A' }, { 'b' }, { 'C' } };
+        EXPECT_EQ( list_f, list_g );
+        list_f.compact();
+        list_g.compact();
+        EXPECT_EQ( list_f, list_g );
+        EXPECT_EQ( list_f, sc::list<CI>( list_g ) );
+        list_g.push_back( { 'd' } );
+        list_f.push_back( { 'e' } );
+        EXPECT_NE( list_f, list_g );
+    }
+    {
+        BEGIN_TEST(tm3, "Splice 6", "moving a single element inside the same list.");
+        which_lib::list<int> list_a{ 1, 2, 3, 4, 5 };
+        which_lib::list<int> list_r{ 4, 1, 2, 3, 5 };
+        auto moved{ std::next( list_a.begin(), 3 ) };
+
+        list_a.splice( list_a.cbegin(), list_a, moved ); // Move to front.
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_a.size(), 5 );
+        EXPECT_TRUE(( moved == list_a.begin() ));
+
+        list_a.splice( list_a.cbegin(), list_a, list_a.begin() ); // Already there.
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( *std::prev( list_a.end() ), 5 );
+    }
+    {
+        BEGIN_TEST(tm3, "Splice 7", "moving a single element between lists.");
+        which_lib::list<int> list_a{ 1, 2, 3 };
+        which_lib::list<int> list_b{ 10, 20, 30 };
+        which_lib::list<int> list_r{ 1, 2, 20, 3 };
+        which_lib::list<int> list_r2{ 10, 30 };
+
+        list_a.splice( std::prev( list_a.cend() ), list_b, std::next( list_b.cbegin() ) );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_r2, list_b );
+        EXPECT_EQ( list_a.size(), 4 );
+        EXPECT_EQ( list_b.size(), 2 );
+    }
+    {
+        BEGIN_TEST(tm3, "Splice 8", "moving a range between lists.");
+        which_lib::list<int> list_a{ 1, 2, 3 };
+        which_lib::list<int> list_b{ 10, 20, 30, 40, 50 };
+        which_lib::list<int> list_r{ 1, 20, 30, 40, 2, 3 };
+        which_lib::list<int> list_r2{ 10, 50 };
+
+        list_a.splice( std::next( list_a.cbegin() ), list_b, std::next( list_b.cbegin() ), std::prev( list_b.cend() ) );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_r2, list_b );
+        EXPECT_EQ( list_a.size(), 6 );
+        EXPECT_EQ( list_b.size(), 2 );
+
+        // Giving the count keeps it O(1).
+        list_b.splice( list_b.cend(), list_a, list_a.cbegin(), std::next( list_a.cbegin(), 2 ), 2 );
+        which_lib::list<int> list_r3{ 30, 40, 2, 3 };
+        which_lib::list<int> list_r4{ 10, 50, 1, 20 };
+        EXPECT_EQ( list_r3, list_a );
+        EXPECT_EQ( list_r4, list_b );
+
+        // Rotating a range inside the same list.
+        list_a.splice( list_a.cbegin(), list_a, std::next( list_a.cbegin(), 2 ), list_a.cend() );
+        which_lib::list<int> list_r5{ 2, 3, 30, 40 };
+        EXPECT_EQ( list_r5, list_a );
+        EXPECT_EQ( list_a.size(), 4 );
+    }
+    {
+        BEGIN_TEST(tm3, "Split 1", "splitting a list in two.");
+        which_lib::list<int> list_a{ 1, 2, 3, 4, 5 };
+        which_lib::list<int> list_r{ 1, 2 };
+        which_lib::list<int> list_r2{ 3, 4, 5 };
+        auto cut{ std::next( list_a.begin(), 2 ) };
+
+        auto list_b = list_a.split( cut );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_r2, list_b );
+        EXPECT_EQ( list_a.size(), 2 );
+        EXPECT_EQ( list_b.size(), 3 );
+        EXPECT_TRUE(( cut == list_b.begin() ));
+
+        auto list_c = list_b.split( list_b.cbegin(), 3 );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_EQ( list_r2, list_c );
+        EXPECT_TRUE( list_a.split( list_a.cend() ).empty() );
+    }
+
     {
         BEGIN_TEST(tm3, "Reverse 1", "reverse a regular list.");
         which_lib::list<int> list_a{ 1, 2, 3, 4, 5 };              // List B
@@ -974,6 +1562,178 @@ int main( void )
         EXPECT_EQ( list_r, list_a ); // List A must be equal to list Result.
     }
 
+    {
+        BEGIN_TEST(tm3, "Unique 5", "links stay valid backwards after unique.");
+        which_lib::list<int> list_a{ 3, 3, 0, 0, 5, 0, 0 };
+        int expected[]{ 0, 5, 0, 3 };
+
+        list_a.unique();
+        EXPECT_EQ( list_a.size(), 4 );
+        auto it = list_a.end();
+        for ( const auto & e : expected )
+        {
+            --it;
+            EXPECT_EQ( *it, e );
+        }
+        EXPECT_TRUE(( it == list_a.begin() ));
+    }
+    {
+        BEGIN_TEST(tm3, "Unique 6", "unique with a binary predicate.");
+        which_lib::list<int> list_a{ 1, 2, 3, 10, 11, 25, 21, 40 };
+        which_lib::list<int> list_r{ 1, 10, 25, 40 };
+
+        // Values in the same decade are duplicates.
+        list_a.unique( []( int a, int b ){ return a / 10 == b / 10; } );
+        EXPECT_EQ( list_r, list_a );
+    }
+    {
+        BEGIN_TEST(tm3, "UniqueAll 1", "removing every duplicate of an unsorted list.");
+        which_lib::list<int> list_a{ 4, 1, 4, 2, 1, 3, 2, 4, 5, 3 };
+        which_lib::list<int> list_r{ 4, 1, 2, 3, 5 };
+        auto first{ list_a.begin() };
+
+        list_a.unique_all();
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_a.size(), 5 );
+        EXPECT_EQ( *std::prev( list_a.end() ), 5 );
+        // Make sure the kept nodes were not recreated.
+        EXPECT_TRUE(( first == list_a.begin() ));
+
+        which_lib::list<int> list_b;
+        list_b.unique_all();
+        EXPECT_TRUE( list_b.empty() );
+    }
+    {
+        BEGIN_TEST(tm3, "UniqueAll 2", "removing duplicates with custom hash and equality.");
+        which_lib::list<std::string> list_a{ "b", "A", "a", "B", "c", "C" };
+        which_lib::list<std::string> list_r{ "b", "A", "c" };
+
+        // Case insensitive, single letter strings.
+        list_a.unique_all( []( const std::string & s ){ return std::hash<char>()( char( std::tolower( s[0] ) ) ); },
+                           []( const std::string & a, const std::string & b ){ return std::tolower( a[0] ) == std::tolower( b[0] ); } );
+        EXPECT_EQ( list_r, list_a );
+    }
+
+    {
+        BEGIN_TEST(tm3, "Remove 1", "removing every occurrence of a value.");
+        which_lib::list<int> list_a{ 2, 1, 2, 3, 2, 2, 4, 2 };
+        which_lib::list<int> list_r{ 1, 3, 4 };
+
+        // The value to remove lives inside the list itself.
+        list_a.remove( *list_a.begin() );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_a.size(), 3 );
+        EXPECT_EQ( *std::prev( list_a.end() ), 4 );
+    }
+    {
+        BEGIN_TEST(tm3, "RemoveIf 1", "removing the values that satisfy a predicate.");
+        which_lib::list<int> list_a{ 1, 2, 3, 4, 5, 6, 7 };
+        which_lib::list<int> list_r{ 1, 3, 5, 7 };
+        auto first{ list_a.begin() };
+
+        list_a.remove_if( []( int e ){ return e % 2 == 0; } );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_TRUE(( first == list_a.begin() ));
+
+        list_a.remove_if( []( int ){ return true; } );
+        EXPECT_TRUE( list_a.empty() );
+        EXPECT_EQ( list_a.size(), 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "Partition 1", "moving the rejected values to another list.");
+        which_lib::list<int> list_a{ 5, 12, 7, 30, 1, 18 };
+        which_lib::list<int> rejected{ 100 };
+        which_lib::list<int> list_r{ 5, 7, 1 };
+        which_lib::list<int> list_r2{ 100, 12, 30, 18 };
+        auto moved{ std::next( list_a.begin() ) };
+
+        list_a.partition( []( int e ){ return e < 10; }, rejected );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_r2, rejected );
+        EXPECT_EQ( rejected.size(), 4 );
+        // The nodes were moved, not copied.
+        EXPECT_TRUE(( moved == std::next( rejected.begin() ) ));
+    }
+    {
+        BEGIN_TEST(tm3, "StablePartition 1", "partitioning a list in place.");
+        which_lib::list<int> list_a{ 5, 12, 7, 30, 1, 18 };
+        which_lib::list<int> list_r{ 12, 30, 18, 5, 7, 1 };
+
+        auto boundary = list_a.stable_partition( []( int e ){ return e >= 10; } );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( *boundary, 5 );
+        EXPECT_EQ( *std::prev( list_a.end() ), 1 );
+
+        boundary = list_a.partition( []( int ){ return true; } );
+        EXPECT_TRUE(( boundary == list_a.end() ));
+        EXPECT_EQ( list_r, list_a );
+    }
+
+    {
+        BEGIN_TEST(tm3, "PartialSort 1", "the k smallest values go to the front, in order.");
+        which_lib::list<int> list_a{ 9, 4, 7, 1, 8, 2, 6, 3, 5 };
+        auto one = std::find( list_a.begin(), list_a.end(), 1 );
+
+        list_a.partial_sort( 4 );
+        which_lib::list<int> first_four{ list_a.begin(), std::next( list_a.begin(), 4 ) };
+        EXPECT_EQ( first_four, ( which_lib::list<int>{ 1, 2, 3, 4 } ) );
+        EXPECT_EQ( list_a.size(), 9 );
+        EXPECT_TRUE(( one == list_a.begin() )); // nodes were relinked, not copied.
+
+        list_a.partial_sort( 3, []( int a, int b ){ return a > b; } );
+        first_four = which_lib::list<int>{ list_a.begin(), std::next( list_a.begin(), 3 ) };
+        EXPECT_EQ( first_four, ( which_lib::list<int>{ 9, 8, 7 } ) );
+
+        list_a.partial_sort( 100 );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9 } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "PartialSort 2", "equal values keep their relative order.");
+        std::vector< std::pair<int, int> > values;
+        which_lib::list< std::pair<int, int> > list_a;
+        std::mt19937 gen{ 38 };
+        std::uniform_int_distribution< int > key{ 0, 50 };
+        for ( int i{0} ; i < 2000 ; ++i ) {
+            values.emplace_back( key( gen ), i );
+            list_a.push_back( values.back() );
+        }
+        auto by_key = []( const std::pair<int, int> & a, const std::pair<int, int> & b ){ return a.first < b.first; };
+        std::stable_sort( values.begin(), values.end(), by_key );
+
+        list_a.partial_sort( 100, by_key );
+        EXPECT_TRUE( std::equal( values.begin(), values.begin() + 100, list_a.begin() ) );
+        EXPECT_EQ( list_a.size(), 2000 );
+    }
+    {
+        BEGIN_TEST(tm3, "NthElement 1", "settling a single position of the list.");
+        std::vector< int > values;
+        which_lib::list<int> list_a;
+        std::mt19937 gen{ 83 };
+        std::uniform_int_distribution< int > value{ 0, 300 };
+        for ( int i{0} ; i < 1000 ; ++i ) {
+            values.push_back( value( gen ) );
+            list_a.push_back( values.back() );
+        }
+        std::sort( values.begin(), values.end() );
+
+        bool settled{ true };
+        for ( size_t k : { size_t(0), size_t(500), size_t(999), size_t(137) } ) {
+            list_a.nth_element( k );
+            auto nth = std::next( list_a.begin(), k );
+            if ( *nth != values[k] )
+                settled = false;
+            for ( auto it = list_a.begin() ; it != nth ; ++it )
+                if ( *it > *nth ) settled = false;
+            for ( auto it = std::next( nth ) ; it != list_a.end() ; ++it )
+                if ( *it < *nth ) settled = false;
+        }
+        EXPECT_TRUE( settled );
+        EXPECT_EQ( list_a.size(), 1000 );
+
+        list_a.sort();
+        EXPECT_TRUE( std::equal( values.begin(), values.end(), list_a.begin() ) );
+    }
+
     {
         BEGIN_TEST(tm3, "Sort 1", "sorting a regular list.");
         which_lib::list<int> list_a{ 4, 2, 1, 5, 3 };              // List B
@@ -1062,9 +1822,1044 @@ int main( void )
         EXPECT_EQ( list_r2, list_a ); // List A must be equal to list Result.
     }
 
+    {
+        BEGIN_TEST(tm3, "Sort 5", "sorting with a comparator and a projection is stable.");
+        which_lib::list<Card> list_a{
+            { 10, "clubs"}, { 4, "hearts" }, { 8, "diamond" }, { 10, "spades" },
+            { 4, "clubs" }, { 7, "spades" }, { 8, "clubs" }
+        };
+        which_lib::list<Card> list_r{
+            { 10, "clubs"}, { 10, "spades" }, { 8, "diamond" }, { 8, "clubs" },
+            { 7, "spades" }, { 4, "hearts" }, { 4, "clubs" }
+        };
+
+        list_a.sort( []( int a, int b ){ return a > b; }, []( const Card & c ){ return c.value; } );
+        EXPECT_EQ( list_r, list_a );
+
+        list_a.sort( []( const Card & a, const Card & b ){ return a.face < b.face; } );
+        EXPECT_EQ( list_a.front(), ( Card{ 10, "clubs" } ) );
+        EXPECT_EQ( list_a.back(), ( Card{ 7, "spades" } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 6", "sorting by cached keys computes each key once.");
+        which_lib::list<Card> list_a{
+            { 10, "clubs"}, { 4, "hearts" }, { 8, "diamond" }, { 10, "spades" },
+            { 4, "clubs" }, { 7, "spades" }, { 8, "clubs" }
+        };
+        which_lib::list<Card> list_r{
+            { 10, "clubs"}, { 4, "clubs" }, { 8, "clubs" }, { 8, "diamond" },
+            { 4, "hearts" }, { 10, "spades" }, { 7, "spades" }
+        };
+        auto first = list_a.begin();
+
+        int calls{ 0 };
+        list_a.sort_by_cached_key( [&calls]( const Card & c ){
+            ++calls;
+            std::string key{ c.face };
+            for ( auto & ch : key ) ch = char( std::toupper( ch ) );
+            return key;
+        } );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( calls, 7 );
+        EXPECT_EQ( *first, ( Card{ 10, "clubs" } ) ); // iterators remain valid.
+        EXPECT_EQ( *std::prev( list_a.end() ), ( Card{ 7, "spades" } ) );
+
+        list_a.sort_by_cached_key( []( const Card & c ){ return c.value; }, []( int a, int b ){ return a > b; } );
+        EXPECT_EQ( list_a.front(), ( Card{ 10, "clubs" } ) );
+        EXPECT_EQ( list_a.back(), ( Card{ 4, "hearts" } ) );
+    }
+
+    {
+        BEGIN_TEST(tm3, "MergeAll 1", "k-way merge of several sorted lists.");
+        std::vector< which_lib::list<int> > shards{
+            { 0, 5, 10, 15 },
+            { },
+            { 1, 2, 3 },
+            { 4, 6, 20 },
+            { 7, 8, 9, 11, 12, 13, 14 }
+        };
+        which_lib::list<int> list_r{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 20 };
+        auto first = shards[4].begin();
+
+        auto merged = sc::merge_all( shards );
+        EXPECT_EQ( list_r, merged );
+        EXPECT_EQ( merged.size(), 17 );
+        bool all_empty{ true };
+        for ( const auto & shard : shards )
+            all_empty = all_empty and shard.empty();
+        EXPECT_TRUE( all_empty );
+        // Nodes are relinked, not copied.
+        EXPECT_TRUE(( first == std::next( merged.begin(), 7 ) ));
+
+        std::vector< which_lib::list<int> > none;
+        EXPECT_TRUE( sc::merge_all( none ).empty() );
+    }
+    {
+        BEGIN_TEST(tm3, "MergeAll 2", "k-way merge with a comparator is stable by shard order.");
+        std::vector< which_lib::list<Card> > shards{
+            { { 9, "clubs" }, { 5, "clubs" }, { 5, "spades" } },
+            { { 9, "hearts" }, { 5, "hearts" } },
+            { { 7, "diamond" }, { 5, "diamond" }, { 1, "diamond" } }
+        };
+        which_lib::list<Card> list_r{
+            { 9, "clubs" }, { 9, "hearts" }, { 7, "diamond" },
+            { 5, "clubs" }, { 5, "spades" }, { 5, "hearts" }, { 5, "diamond" },
+            { 1, "diamond" }
+        };
+
+        auto merged = sc::merge_all( shards, []( const Card & a, const Card & b ){ return a.value > b.value; } );
+        EXPECT_EQ( list_r, merged );
+    }
+
     std::cout << std::endl;
     tm3.summary();
 
+    //=== TESTING CONCURRENT CONTAINERS
+    TestManager tm4{ "Concurrency Test Suite"};
+
+    {
+        BEGIN_TEST(tm4, "SPSC 1", "push_back/pop_front on a single thread.");
+        sc::spsc_list<int> queue;
+        int value{ 0 };
+
+        EXPECT_TRUE( queue.empty() );
+        EXPECT_FALSE( queue.pop_front( value ) );
+
+        for ( int i{0} ; i < 10 ; ++i )
+            queue.push_back( i );
+        EXPECT_FALSE( queue.empty() );
+
+        bool in_order{ true };
+        for ( int i{0} ; i < 10 ; ++i )
+            in_order = in_order and queue.pop_front( value ) and value == i;
+        EXPECT_TRUE( in_order );
+        EXPECT_TRUE( queue.empty() );
+    }
+    {
+        BEGIN_TEST(tm4, "SPSC 2", "one producer and one consumer thread keep FIFO order.");
+        sc::spsc_list<int> queue;
+        const int n_values{ 200000 };
+
+        std::thread producer{ [&queue, n_values]() {
+            for ( int i{0} ; i < n_values ; ++i )
+                queue.push_back( i );
+        } };
+
+        bool in_order{ true };
+        int expected{ 0 };
+        int value{ 0 };
+        while ( expected < n_values )
+            if ( queue.pop_front( value ) )
+                in_order = in_order and value == expected++;
+        producer.join();
+
+        EXPECT_TRUE( in_order );
+        EXPECT_TRUE( queue.empty() );
+    }
+
+    {
+        BEGIN_TEST(tm4, "RCU 1", "writer operations on a single thread.");
+        sc::rcu_list<int> list;
+        list.push_back( 2 );
+        list.push_back( 4 );
+        list.push_front( 1 );
+        list.insert( std::next( list.cbegin(), 2 ), 3 );
+        list.erase( std::next( list.cbegin(), 1 ) );
+
+        sc::rcu_list<int>::reader reader{ list };
+        auto guard = reader.enter();
+        int expected[]{ 1, 3, 4 };
+        auto it = list.cbegin();
+        for ( const auto & e : expected )
+            EXPECT_EQ( *it++, e );
+        EXPECT_TRUE(( it == list.cend() ));
+        EXPECT_EQ( list.size(), 3 );
+
+        // A nested critical section must not end the outer one.
+        auto second = std::next( list.cbegin() );
+        {
+            auto inner = reader.enter();
+        }
+        list.erase( second );
+        EXPECT_EQ( *second, 3 );
+        EXPECT_EQ( list.size(), 2 );
+    }
+    {
+        BEGIN_TEST(tm4, "RCU 2", "readers traverse while a writer inserts and erases.");
+        sc::rcu_list<int> list;
+        for ( int i{0} ; i < 100 ; i += 2 )
+            list.push_back( i );
+
+        std::atomic<bool> done{ false };
+        std::atomic<bool> consistent{ true };
+        std::vector<std::thread> readers;
+        for ( int r{0} ; r < 4 ; ++r )
+            readers.emplace_back( [&list, &done, &consistent]() {
+                sc::rcu_list<int>::reader reader{ list };
+                while ( not done.load() )
+                {
+                    auto guard = reader.enter();
+                    // The even values are never erased and must always show up, in order.
+                    int next_even{ 0 };
+                    for ( auto it = list.cbegin() ; it != list.cend() ; ++it )
+                    {
+                        if ( *it % 2 != 0 ) continue;
+                        if ( *it != next_even ) consistent = false;
+                        next_even += 2;
+                    }
+                    if ( next_even != 100 ) consistent = false;
+                }
+            } );
+
+        // The writer churns odd values between the even ones.
+        for ( int round{0} ; round < 2000 ; ++round )
+        {
+            auto pos = std::next( list.cbegin(), 1 + round % 49 );
+            auto added = list.insert( pos, 2 * ( round % 49 ) + 1 );
+            list.erase( added );
+        }
+        done = true;
+        for ( auto & t : readers )
+            t.join();
+        list.synchronize();
+
+        EXPECT_TRUE( consistent.load() );
+        EXPECT_EQ( list.size(), 50 );
+    }
+
+    {
+        BEGIN_TEST(tm4, "Channel 1", "batches are received in the order they were sent.");
+        sc::chain_channel<int> channel;
+        sc::list<int> batch_a{ 1, 2, 3 };
+        sc::list<int> batch_b{ 4, 5 };
+        sc::list<int> received{ 0 };
+        sc::list<int> list_r{ 0, 1, 2, 3, 4, 5 };
+
+        EXPECT_TRUE( channel.empty() );
+        channel.send( batch_a );
+        channel.send( batch_b );
+        EXPECT_TRUE( batch_a.empty() );
+        EXPECT_TRUE( batch_b.empty() );
+        EXPECT_FALSE( channel.empty() );
+
+        EXPECT_EQ( channel.receive( received ), 5 );
+        EXPECT_EQ( list_r, received );
+        EXPECT_EQ( received.size(), 6 );
+        EXPECT_TRUE( channel.empty() );
+        EXPECT_EQ( channel.receive( received ), 0 );
+    }
+    {
+        BEGIN_TEST(tm4, "Channel 2", "several producers hand batches to one consumer.");
+        sc::chain_channel<int> channel;
+        const int n_producers{ 3 };
+        const int n_batches{ 200 };
+        const int batch_size{ 100 };
+
+        std::vector<std::thread> producers;
+        for ( int p{0} ; p < n_producers ; ++p )
+            producers.emplace_back( [&channel, p, n_batches, batch_size]() {
+                int value{ 0 };
+                for ( int b{0} ; b < n_batches ; ++b )
+                {
+                    sc::list<int> batch;
+                    for ( int i{0} ; i < batch_size ; ++i )
+                        batch.push_back( p * 1000000 + value++ );
+                    channel.send( batch );
+                }
+            } );
+
+        sc::list<int> received;
+        size_t total{ 0 };
+        while ( total < size_t( n_producers * n_batches * batch_size ) )
+            total += channel.receive( received );
+        for ( auto & t : producers )
+            t.join();
+
+        // Each producer's values must arrive complete and in order.
+        std::vector<int> next_value( n_producers, 0 );
+        bool in_order{ true };
+        for ( auto e : received )
+            in_order = in_order and e % 1000000 == next_value[ e / 1000000 ]++;
+        EXPECT_TRUE( in_order );
+        EXPECT_EQ( received.size(), total );
+    }
+
+    {
+        BEGIN_TEST(tm4, "WSDeque 1", "owner and thief ends on a single thread.");
+        sc::ws_deque<int> deque;
+        for ( int i{1} ; i <= 6 ; ++i )
+            deque.push_back( i );
+
+        sc::list<int> loot;
+        sc::list<int> list_r{ 1, 2, 3 };
+        EXPECT_EQ( deque.steal_half( loot ), 3 );
+        EXPECT_EQ( list_r, loot );
+
+        int value{ 0 };
+        EXPECT_TRUE( deque.pop_back( value ) );
+        EXPECT_EQ( value, 6 );
+        EXPECT_TRUE( deque.steal( value ) );
+        EXPECT_EQ( value, 4 );
+        // The last element is left for the owner.
+        EXPECT_FALSE( deque.steal( value ) );
+        EXPECT_TRUE( deque.pop_back( value ) );
+        EXPECT_EQ( value, 5 );
+        EXPECT_FALSE( deque.pop_back( value ) );
+        EXPECT_TRUE( deque.empty() );
+
+        deque.splice_back( loot );
+        EXPECT_TRUE( loot.empty() );
+        EXPECT_EQ( deque.size(), 3 );
+    }
+    {
+        BEGIN_TEST(tm4, "WSDeque 2", "parallel quicksort with work stealing.");
+        struct range { size_t lo; size_t hi; };
+        const size_t n_workers{ 4 };
+        std::vector<int> data( 100000 );
+        std::mt19937 gen{ 42 };
+        for ( auto & e : data )
+            e = int( gen() % 10000 );
+
+        sc::ws_deque<range> deques[ n_workers ];
+        std::atomic<size_t> placed{ 0 }; // Elements already in their final position.
+        deques[0].push_back( { 0, data.size() } );
+
+        auto worker = [&]( size_t id ) {
+            while ( placed.load() < data.size() )
+            {
+                range r;
+                if ( not deques[id].pop_back( r ) )
+                {
+                    // Nothing left locally: take half of somebody else's work.
+                    for ( size_t v{1} ; v < n_workers ; ++v )
+                    {
+                        sc::list<range> loot;
+                        if ( deques[ ( id + v ) % n_workers ].steal_half( loot ) > 0 )
+                        {
+                            deques[id].splice_back( loot );
+                            break;
+                        }
+                    }
+                    continue;
+                }
+
+                auto first = data.begin() + r.lo;
+                auto last = data.begin() + r.hi;
+                if ( r.hi - r.lo <= 64 )
+                {
+                    std::sort( first, last );
+                    placed += r.hi - r.lo;
+                    continue;
+                }
+                auto pivot = *( first + ( r.hi - r.lo ) / 2 );
+                auto mid1 = std::partition( first, last, [pivot]( int e ){ return e < pivot; } );
+                auto mid2 = std::partition( mid1, last, [pivot]( int e ){ return e == pivot; } );
+                placed += size_t( mid2 - mid1 );
+                deques[id].push_back( { r.lo, size_t( mid1 - data.begin() ) } );
+                deques[id].push_back( { size_t( mid2 - data.begin() ), r.hi } );
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for ( size_t id{0} ; id < n_workers ; ++id )
+            workers.emplace_back( worker, id );
+        for ( auto & t : workers )
+            t.join();
+
+        EXPECT_TRUE( std::is_sorted( data.begin(), data.end() ) );
+        EXPECT_EQ( placed.load(), data.size() );
+    }
+
+    {
+        BEGIN_TEST(tm4, "Par 1", "for_each and transform_inplace visit every element once.");
+        sc::list<int> list_a( 10001 );
+        sc::list<int> list_r;
+        for ( int i{0} ; i < 10001 ; ++i )
+            list_r.push_back( 2 * ( i + 1 ) );
+
+        int i{0};
+        for ( auto & e : list_a )
+            e = i++;
+        sc::par::for_each( list_a, []( int & e ){ e += 1; }, 3 );
+        sc::par::transform_inplace( list_a, []( int e ){ return 2 * e; }, 3 );
+        EXPECT_EQ( list_r, list_a );
+
+        // More workers than elements.
+        sc::list<int> list_b{ 1, 2 };
+        sc::par::for_each( list_b, []( int & e ){ e *= 10; }, 8 );
+        sc::list<int> list_r2{ 10, 20 };
+        EXPECT_EQ( list_r2, list_b );
+    }
+    {
+        BEGIN_TEST(tm4, "Par 2", "reduce is correct and deterministic.");
+        sc::list<int> list_a;
+        sc::list<double> list_b;
+        for ( int i{1} ; i <= 10000 ; ++i )
+        {
+            list_a.push_back( i );
+            list_b.push_back( 1.0 / i );
+        }
+
+        EXPECT_EQ( sc::par::reduce( list_a, 0, []( int a, int b ){ return a + b; }, 4 ), 50005000 );
+        auto sum1 = sc::par::reduce( list_b, 0.0, []( double a, double b ){ return a + b; }, 4 );
+        auto sum2 = sc::par::reduce( list_b, 0.0, []( double a, double b ){ return a + b; }, 4 );
+        EXPECT_EQ( sum1, sum2 );
+        // The same result whatever the number of workers.
+        EXPECT_EQ( sc::par::reduce( list_b, 0.0, []( double a, double b ){ return a + b; }, 1 ), sum1 );
+        EXPECT_EQ( sc::par::reduce( list_b, 0.0, []( double a, double b ){ return a + b; }, 3 ), sum1 );
+        EXPECT_EQ( sc::par::reduce( list_b, 0.0, []( double a, double b ){ return a + b; } ), sum1 );
+
+        sc::list<bool> list_c;
+        for ( int i{0} ; i < 5000 ; ++i )
+            list_c.push_back( i != 4321 );
+        EXPECT_FALSE( sc::par::reduce( list_c, true, []( bool a, bool b ){ return a and b; }, 4 ) );
+        EXPECT_EQ( sc::par::reduce( sc::list<int>{}, 7, []( int a, int b ){ return a + b; } ), 7 );
+    }
+    {
+        BEGIN_TEST(tm4, "Par 3", "the thread pool is reused, runs nested batches and forwards exceptions.");
+        sc::par::thread_pool pool( 2 );
+        EXPECT_EQ( pool.size(), 2 );
+
+        // Every task of every batch runs on the caller or on one of the two pool threads.
+        std::mutex ids_mutex;
+        std::vector< std::thread::id > ids;
+        std::atomic< int > done{ 0 };
+        auto record = [&]( size_t ){
+            std::lock_guard< std::mutex > lock( ids_mutex );
+            if ( std::find( ids.begin(), ids.end(), std::this_thread::get_id() ) == ids.end() )
+                ids.push_back( std::this_thread::get_id() );
+            done++;
+        };
+        for ( int i{0} ; i < 20 ; ++i )
+            pool.run( 8, record );
+        EXPECT_EQ( done.load(), 160 );
+        EXPECT_TRUE(( ids.size() <= 3 ));
+
+        // A task that runs a batch itself.
+        std::atomic< int > inner_done{ 0 };
+        auto inner = [&]( size_t ){ inner_done++; };
+        auto outer = [&]( size_t ){ pool.run( 5, inner ); };
+        pool.run( 4, outer );
+        EXPECT_EQ( inner_done.load(), 20 );
+
+        auto failing = []( size_t i ){ if ( i == 3 ) throw std::runtime_error( "task 3" ); };
+        bool thrown{ false };
+        try { pool.run( 6, failing ); }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm4, "ParMerge 1", "parallel merge of two large sorted lists.");
+        sc::list<int> list_a;
+        sc::list<int> list_b;
+        sc::list<int> list_r;
+        for ( int i{0} ; i < 60000 ; ++i )
+        {
+            list_r.push_back( i );
+            if ( i % 3 == 0 ) list_b.push_back( i );
+            else list_a.push_back( i );
+        }
+
+        sc::par::merge( list_a, list_b, 4 );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_a.size(), 60000 );
+        EXPECT_TRUE( list_b.empty() );
+
+        // A small merge falls back to list::merge.
+        sc::list<int> list_c{ 1, 3, 5 };
+        sc::list<int> list_d{ 2, 4 };
+        sc::list<int> list_r2{ 1, 2, 3, 4, 5 };
+        sc::par::merge( list_c, list_d, 4 );
+        EXPECT_EQ( list_r2, list_c );
+    }
+    {
+        BEGIN_TEST(tm4, "ParMerge 2", "parallel merge is stable, whichever list is longer.");
+        struct Item {
+            int key; int from;
+            inline bool operator<( const Item &a ) const { return key < a.key; }
+        };
+
+        bool stable{ true };
+        for ( int longer{0} ; longer < 2 ; ++longer )
+        {
+            sc::list<Item> list_a;
+            sc::list<Item> list_b;
+            for ( int i{0} ; i < 40000 ; ++i )
+                list_a.push_back( { i / 7, 0 } );
+            for ( int i{0} ; i < ( longer == 0 ? 20000 : 90000 ) ; ++i )
+                list_b.push_back( { i / 11, 1 } );
+            auto total = list_a.size() + list_b.size();
+
+            sc::par::merge( list_a, list_b, 4 );
+            stable = stable and list_a.size() == total and list_b.empty();
+
+            // Keys never decrease, and equal keys from list A come first.
+            Item prev{ -1, 0 };
+            for ( const auto & e : list_a )
+            {
+                if ( e.key < prev.key or ( e.key == prev.key and e.from < prev.from ) )
+                    stable = false;
+                prev = e;
+            }
+        }
+        EXPECT_TRUE( stable );
+    }
+    {
+        BEGIN_TEST(tm4, "ParMerge 3", "parallel merge with a comparator, on lists of very different shapes.");
+        std::mt19937 gen( 17 );
+        std::uniform_int_distribution< int > dist( 0, 5000 );
+        std::vector< int > values_a( 70000 );
+        std::vector< int > values_b( 30000 );
+        for ( auto & v : values_a ) v = dist( gen );
+        for ( auto & v : values_b ) v = dist( gen ) / 50; // Many duplicates, all near the end.
+        std::sort( values_a.begin(), values_a.end(), std::greater< int >() );
+        std::sort( values_b.begin(), values_b.end(), std::greater< int >() );
+
+        std::vector< int > values_r( values_a );
+        values_r.insert( values_r.end(), values_b.begin(), values_b.end() );
+        std::sort( values_r.begin(), values_r.end(), std::greater< int >() );
+
+        sc::list<int> list_a( values_a.begin(), values_a.end() );
+        sc::list<int> list_b( values_b.begin(), values_b.end() );
+        sc::list<int> list_r( values_r.begin(), values_r.end() );
+        sc::par::merge( list_a, list_b, std::greater< int >(), 6 );
+        EXPECT_EQ( list_r, list_a );
+        EXPECT_EQ( list_a.size(), 100000 );
+        EXPECT_TRUE( list_b.empty() );
+
+        // Every value of list C goes after those of list D.
+        sc::list<int> list_c;
+        sc::list<int> list_d;
+        for ( int i{0} ; i < 50000 ; ++i )
+        {
+            list_c.push_back( 1 );
+            list_d.push_back( 9 );
+        }
+        sc::par::merge( list_c, list_d, std::greater< int >(), 4 );
+        EXPECT_EQ( list_c.front(), 9 );
+        EXPECT_EQ( list_c.back(), 1 );
+        EXPECT_EQ( list_c.size(), 100000 );
+        EXPECT_TRUE( std::is_sorted( list_c.begin(), list_c.end(), std::greater< int >() ) );
+
+        // A single element merged into a long list, and the other way around.
+        sc::list<int> list_e;
+        for ( int i{0} ; i < 40000 ; ++i )
+            list_e.push_back( 2 * i );
+        sc::list<int> list_f{ 20001 };
+        sc::par::merge( list_e, list_f, 4 );
+        sc::par::merge( list_f, list_e, 4 );
+        EXPECT_EQ( list_f.size(), 40001 );
+        EXPECT_TRUE( list_e.empty() );
+        EXPECT_TRUE( std::is_sorted( list_f.begin(), list_f.end() ) );
+    }
+
+    std::cout << std::endl;
+    tm4.summary();
+
+    //=== TESTING CONTAINERS BUILT ON TOP OF THE LIST
+    TestManager tm5{ "Adaptors Test Suite"};
+
+    {
+        BEGIN_TEST(tm5, "LRU 1", "hits, misses and eviction of the least recently used entry.");
+        std::vector< int > evicted;
+        sc::lru_cache< int, std::string > cache{ 3, [&evicted]( const int & key, std::string & ){ evicted.push_back( key ); } };
+
+        cache.put( 1, "one" );
+        cache.put( 2, "two" );
+        cache.put( 3, "three" );
+        EXPECT_EQ( *cache.get( 1 ), "one" );  // 1 becomes the most recent.
+        cache.put( 4, "four" );                // evicts 2.
+        EXPECT_TRUE(( cache.get( 2 ) == nullptr ));
+        cache.put( 3, "THREE" );               // update, 3 becomes the most recent.
+        cache.put( 5, "five" );                // evicts 1.
+
+        EXPECT_EQ( cache.size(), 3u );
+        EXPECT_FALSE( cache.contains( 1 ) );
+        EXPECT_EQ( *cache.get( 3 ), "THREE" );
+        EXPECT_EQ( evicted, ( std::vector< int >{ 2, 1 } ) );
+        EXPECT_EQ( cache.hits(), 2u );
+        EXPECT_EQ( cache.misses(), 1u );
+
+        EXPECT_TRUE( cache.erase( 4 ) );
+        EXPECT_FALSE( cache.erase( 4 ) );
+        EXPECT_EQ( cache.size(), 2u );
+    }
+    {
+        BEGIN_TEST(tm5, "LRU 2", "agrees with a reference model on a random workload.");
+        sc::lru_cache< int, int > cache{ 64 };
+        std::list< int > model; // most recent first.
+        std::mt19937 gen{ 37 };
+        std::uniform_int_distribution< int > key{ 0, 200 };
+        bool same{ true };
+
+        for ( int i{0}; i < 20000; ++i ) {
+            auto k = key( gen );
+            auto found = std::find( model.begin(), model.end(), k );
+            if ( i % 3 == 0 ) {
+                auto v = cache.get( k );
+                if ( ( v != nullptr ) != ( found != model.end() ) or ( v != nullptr and *v != k ) )
+                    same = false;
+                if ( found != model.end() )
+                    model.splice( model.begin(), model, found );
+            } else {
+                cache.put( k, k );
+                if ( found != model.end() )
+                    model.erase( found );
+                else if ( model.size() == 64 )
+                    model.pop_back();
+                model.push_front( k );
+            }
+        }
+        for ( auto k : model )
+            if ( not cache.contains( k ) )
+                same = false;
+        EXPECT_TRUE( same );
+        EXPECT_EQ( cache.size(), model.size() );
+    }
+    {
+        BEGIN_TEST(tm5, "LFU 1", "evicts the least frequently used entry, oldest first on ties.");
+        std::vector< int > evicted;
+        sc::lfu_cache< int, int > cache{ 3, [&evicted]( const int & key, int & ){ evicted.push_back( key ); } };
+
+        cache.put( 1, 10 );
+        cache.put( 2, 20 );
+        cache.put( 3, 30 );
+        cache.get( 1 );
+        cache.get( 1 );
+        cache.get( 2 );
+        EXPECT_EQ( cache.uses( 1 ), 3u );
+        cache.put( 4, 40 );       // 3 has the fewest uses.
+        cache.put( 5, 50 );       // 4 is the only one with a single use.
+        cache.get( 5 );
+        cache.put( 6, 60 );       // 2 and 5 have two uses, 2 is older.
+
+        EXPECT_EQ( evicted, ( std::vector< int >{ 3, 4, 2 } ) );
+        EXPECT_EQ( *cache.get( 1 ), 10 );
+        EXPECT_EQ( cache.size(), 3u );
+        EXPECT_TRUE( cache.contains( 5 ) );
+        EXPECT_TRUE( cache.contains( 6 ) );
+    }
+    {
+        BEGIN_TEST(tm5, "LFU 2", "agrees with a reference model on a random workload.");
+        struct Model{ int key; size_t uses; int touched; };
+        sc::lfu_cache< int, int > cache{ 32 };
+        std::vector< Model > model;
+        std::mt19937 gen{ 41 };
+        std::uniform_int_distribution< int > key{ 0, 100 };
+        bool same{ true };
+
+        for ( int i{0}; i < 20000; ++i ) {
+            auto k = key( gen );
+            auto found = std::find_if( model.begin(), model.end(), [k]( const Model & m ){ return m.key == k; } );
+            if ( i % 2 == 0 ) {
+                auto v = cache.get( k );
+                if ( ( v != nullptr ) != ( found != model.end() ) )
+                    same = false;
+                if ( found != model.end() )
+                    *found = { k, found->uses + 1, i };
+                continue;
+            }
+            if ( found != model.end() ) {
+                *found = { k, found->uses + 1, i };
+            } else {
+                if ( model.size() == 32 )
+                    model.erase( std::min_element( model.begin(), model.end(), []( const Model & a, const Model & b ){
+                        return a.uses < b.uses or ( a.uses == b.uses and a.touched < b.touched ); } ) );
+                model.push_back( { k, 1, i } );
+            }
+            cache.put( k, k );
+        }
+        for ( const auto & m : model )
+            if ( cache.uses( m.key ) != m.uses )
+                same = false;
+        EXPECT_TRUE( same );
+        EXPECT_EQ( cache.size(), model.size() );
+    }
+    {
+        BEGIN_TEST(tm5, "SortedList 1", "inserts keep the list sorted and equal keys in arrival order.");
+        using Entry = std::pair<int, char>;
+        auto by_key = []( const Entry & a, const Entry & b ){ return a.first < b.first; };
+        sc::sorted_list< Entry, decltype( by_key ) > list_a{ by_key };
+
+        for ( const auto & e : { Entry{ 5, 'a' }, Entry{ 1, 'b' }, Entry{ 5, 'c' }, Entry{ 3, 'd' },
+                                 Entry{ 9, 'e' }, Entry{ 3, 'f' }, Entry{ 4, 'g' }, Entry{ 5, 'h' } } )
+            list_a.insert( e );
+
+        sc::list< Entry > list_r{ { 1, 'b' }, { 3, 'd' }, { 3, 'f' }, { 4, 'g' },
+                                  { 5, 'a' }, { 5, 'c' }, { 5, 'h' }, { 9, 'e' } };
+        EXPECT_EQ( list_a.values(), list_r );
+
+        auto fives = list_a.equal_range( Entry{ 5, ' ' } );
+        EXPECT_EQ( std::distance( fives.first, fives.second ), 3 );
+        EXPECT_EQ( ( *fives.first ).second, 'a' );
+        EXPECT_EQ( ( *list_a.lower_bound( Entry{ 2, ' ' } ) ).first, 3 );
+        EXPECT_EQ( ( *list_a.upper_bound( Entry{ 4, ' ' } ) ).first, 5 );
+        EXPECT_TRUE(( list_a.lower_bound( Entry{ 10, ' ' } ) == list_a.end() ));
+        EXPECT_FALSE( list_a.contains( Entry{ 2, ' ' } ) );
+
+        EXPECT_EQ( list_a.erase( Entry{ 5, ' ' } ), 3 );
+        EXPECT_EQ( list_a.size(), 5 );
+        EXPECT_EQ( list_a.back().first, 9 );
+    }
+    {
+        BEGIN_TEST(tm5, "SortedList 2", "finger inserts and bulk inserts agree with a full sort.");
+        sc::sorted_list< int > list_a;
+        std::vector< int > values;
+        std::mt19937 gen{ 40 };
+        std::uniform_int_distribution< int > jitter{ -5, 5 };
+
+        // A nearly sorted stream, then random batches.
+        for ( int i{0} ; i < 3000 ; ++i ) {
+            values.push_back( i + jitter( gen ) );
+            list_a.insert( values.back() );
+        }
+        std::uniform_int_distribution< int > value{ -100, 4000 };
+        for ( int b{0} ; b < 5 ; ++b ) {
+            std::vector< int > batch;
+            for ( int i{0} ; i < 200 ; ++i )
+                batch.push_back( value( gen ) );
+            list_a.insert( batch.begin(), batch.end() );
+            values.insert( values.end(), batch.begin(), batch.end() );
+
+            values.push_back( value( gen ) );
+            list_a.insert( values.back() );
+        }
+        std::sort( values.begin(), values.end() );
+        EXPECT_EQ( list_a.size(), values.size() );
+        EXPECT_TRUE( std::equal( values.begin(), values.end(), list_a.begin() ) );
+    }
+    {
+        BEGIN_TEST(tm5, "SortedList 3", "a value far from the finger is found from the nearer end.");
+        struct counting_less {
+            size_t * calls;
+            bool operator()( int a, int b ) const { ++*calls; return a < b; }
+        };
+        size_t calls{ 0 };
+        sc::sorted_list< int, counting_less > list_a( counting_less{ &calls } );
+        std::vector< int > evens;
+        for ( int i{0} ; i < 20000 ; i += 2 )
+            evens.push_back( i );
+        list_a.insert( evens.begin(), evens.end() );
+        list_a.insert( 10001 ); // The finger is now in the middle.
+
+        // Values next to the front and next to the back, in turns.
+        bool cheap{ true };
+        for ( int i{0} ; i < 20 ; ++i ) {
+            calls = 0;
+            list_a.insert( i % 2 == 0 ? 5 + i : 19995 - i );
+            cheap = cheap and calls < 64;
+        }
+        EXPECT_TRUE( cheap );
+        EXPECT_EQ( list_a.size(), 10021 );
+        EXPECT_TRUE( std::is_sorted( list_a.begin(), list_a.end() ) );
+
+        // Values cannot be changed through the iterators of a sorted list.
+        EXPECT_TRUE(( std::is_same< decltype( *std::declval< sc::sorted_list< int >::const_iterator & >() ), const int & >::value ));
+    }
+    {
+        BEGIN_TEST(tm5, "HotCold 1", "sort, reverse, merge and splice keep each key with its payload.");
+        struct Record { int id; char blob[512]; };
+        struct id_of { int operator()( const Record & r ) const { return r.id; } };
+        auto record = []( int id ){ Record r{}; r.id = id; r.blob[511] = char( id ); return r; };
+        auto ids = []( const sc::hot_cold_list< Record, id_of > & l ){
+            std::vector< int > out;
+            for ( auto it = l.begin() ; it != l.end() ; ++it ) {
+                if ( it.key() != ( *it ).id or ( *it ).blob[511] != char( ( *it ).id ) )
+                    out.push_back( -1 );
+                out.push_back( it.key() );
+            }
+            return out;
+        };
+
+        sc::hot_cold_list< Record, id_of > list_a, list_b;
+        for ( int id : { 7, 3, 9, 1 } )
+            list_a.push_back( record( id ) );
+        for ( int id : { 8, 2, 4 } )
+            list_b.push_front( record( id ) );
+
+        list_a.sort();
+        list_b.sort();
+        list_a.merge( list_b );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 1, 2, 3, 4, 7, 8, 9 } ) );
+
+        list_a.reverse();
+        list_a.sort( []( int a, int b ){ return a % 2 < b % 2; } );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 8, 4, 2, 9, 7, 3, 1 } ) );
+
+        list_b.push_back( record( 5 ) );
+        list_a.splice( std::next( list_a.begin() ), list_b );
+        list_a.erase( list_a.begin() );
+        list_a.modify( list_a.begin(), []( Record & r ){ r.id = 6; r.blob[511] = char( 6 ); } );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 6, 4, 2, 9, 7, 3, 1 } ) );
+
+        sc::hot_cold_list< Record, id_of > list_c{ list_a };
+        list_a.clear();
+        EXPECT_EQ( list_c.size(), 7 );
+        EXPECT_EQ( list_c.back().id, 1 );
+        EXPECT_EQ( list_c.links().front().key, 6 );
+    }
+    {
+        BEGIN_TEST(tm5, "SmallList 1", "up to N values live inside the list object; more spill to the heap.");
+        using Small = sc::small_list< int, 4 >;
+        auto inside = []( const Small & l ){
+            size_t count{0};
+            for ( auto it = l.begin() ; it != l.end() ; ++it ) {
+                auto p = reinterpret_cast< const char * >( &*it );
+                if ( p >= reinterpret_cast< const char * >( &l ) and p < reinterpret_cast< const char * >( &l + 1 ) )
+                    count++;
+            }
+            return count;
+        };
+
+        Small list_a{ 1, 2, 3 };
+        EXPECT_EQ( inside( list_a ), 3 );
+
+        list_a.push_front( 0 );
+        list_a.push_back( 4 );
+        list_a.push_back( 5 );
+        EXPECT_EQ( list_a.size(), 6 );
+        EXPECT_EQ( inside( list_a ), 4 );
+        EXPECT_TRUE( std::equal( list_a.begin(), list_a.end(), std::vector< int >{ 0, 1, 2, 3, 4, 5 }.begin() ) );
+
+        // Freed inline slots are taken again before the heap.
+        list_a.erase( std::next( list_a.begin() ) );
+        list_a.pop_front();
+        list_a.insert( list_a.begin(), 9 );
+        EXPECT_EQ( inside( list_a ), 3 );
+
+        list_a.reverse();
+        EXPECT_TRUE( std::equal( list_a.begin(), list_a.end(), std::vector< int >{ 5, 4, 3, 2, 9 }.begin() ) );
+        EXPECT_EQ( list_a.front(), 5 );
+        EXPECT_EQ( list_a.back(), 9 );
+
+        Small list_b{ list_a };
+        EXPECT_EQ( inside( list_b ), 4 );
+        EXPECT_EQ( list_b.size(), 5 );
+    }
+    {
+        BEGIN_TEST(tm5, "SmallList 2", "splice and merge across the inline/heap boundary agree with std::list.");
+        sc::small_list< int, 3 > list_a, list_b;
+        std::list< int > ref_a, ref_b;
+        std::mt19937 gen{ 45 };
+        std::uniform_int_distribution< int > value{ 0, 20 };
+
+        for ( int round{0} ; round < 50 ; ++round ) {
+            for ( int i{0} ; i < round % 7 ; ++i ) {
+                auto v = value( gen );
+                list_b.push_back( v );
+                ref_b.push_back( v );
+            }
+            if ( round % 3 == 0 ) {
+                std::vector< int > sorted( list_b.begin(), list_b.end() );
+                std::sort( sorted.begin(), sorted.end() );
+                sc::small_list< int, 3 > list_c;
+                for ( auto v : sorted )
+                    list_c.push_back( v );
+                list_b = std::move( list_c );
+                ref_b.sort();
+                if ( std::is_sorted( list_a.begin(), list_a.end() ) ) {
+                    list_a.merge( list_b );
+                    ref_a.merge( ref_b );
+                }
+            } else if ( round % 3 == 1 and not list_b.empty() ) {
+                list_a.splice( list_a.begin(), list_b, std::prev( list_b.end() ) );
+                ref_a.splice( ref_a.begin(), ref_b, std::prev( ref_b.end() ) );
+            } else {
+                auto pos = list_a.begin();
+                auto ref_pos = ref_a.begin();
+                for ( size_t i{0} ; i < list_a.size() / 2 ; ++i, ++pos, ++ref_pos ) {}
+                list_a.splice( pos, list_b );
+                ref_a.splice( ref_pos, ref_b );
+            }
+            if ( list_a.size() > 12 ) {
+                list_a.clear();
+                ref_a.clear();
+            }
+        }
+        EXPECT_EQ( list_a.size(), ref_a.size() );
+        EXPECT_TRUE( std::equal( ref_a.begin(), ref_a.end(), list_a.begin() ) );
+        EXPECT_EQ( list_b.size(), ref_b.size() );
+        EXPECT_TRUE( std::equal( ref_b.begin(), ref_b.end(), list_b.begin() ) );
+    }
+    {
+        BEGIN_TEST(tm5, "Intrusive 1", "links the caller's objects in place, without copies.");
+        struct Task { int id; sc::list_hook hook; };
+        using Tasks = sc::intrusive_list< Task, &Task::hook >;
+        auto by_id = []( const Task & a, const Task & b ){ return a.id < b.id; };
+        auto ids = []( const Tasks & l ){
+            std::vector< int > out;
+            for ( const auto & t : l )
+                out.push_back( t.id );
+            return out;
+        };
+
+        std::vector< Task > pool( 8 );
+        for ( size_t i{0} ; i < pool.size() ; ++i )
+            pool[i].id = int( ( i * 5 ) % 8 );   // 0 5 2 7 4 1 6 3
+
+        Tasks list_a, list_b;
+        for ( size_t i{0} ; i < 5 ; ++i )
+            list_a.push_back( pool[i] );
+        for ( size_t i{5} ; i < 8 ; ++i )
+            list_b.push_front( pool[i] );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 0, 5, 2, 7, 4 } ) );
+        EXPECT_EQ( ids( list_b ), ( std::vector< int >{ 3, 6, 1 } ) );
+        EXPECT_EQ( &list_a.front(), &pool[0] );
+
+        list_a.sort( by_id );
+        list_b.sort( by_id );
+        list_a.merge( list_b, by_id );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+
+        // iterator_to is O(1) and points at the object itself.
+        auto it = Tasks::iterator_to( pool[5] );
+        EXPECT_EQ( &*it, &pool[5] );
+        EXPECT_EQ( std::next( it )->id, 2 );
+        list_b.splice( list_b.cend(), list_a, Tasks::iterator_to( pool[2] ), list_a.cend() );
+        EXPECT_EQ( ids( list_a ), ( std::vector< int >{ 0, 1 } ) );
+        EXPECT_EQ( ids( list_b ), ( std::vector< int >{ 2, 3, 4, 5, 6, 7 } ) );
+
+        list_b.reverse();
+        list_b.erase( Tasks::iterator_to( pool[4] ) );
+        EXPECT_FALSE( pool[4].hook.is_linked() );
+        EXPECT_EQ( ids( list_b ), ( std::vector< int >{ 7, 6, 5, 3, 2 } ) );
+        EXPECT_EQ( list_b.size(), 5 );
+    }
+    {
+        BEGIN_TEST(tm5, "Intrusive 2", "hooks unlink themselves; unique and a stable sort.");
+        struct Item { int key; char tag; sc::list_hook hook; };
+        using Items = sc::intrusive_list< Item, &Item::hook >;
+        Items items;
+
+        Item a{ 2, 'a', {} }, b{ 1, 'b', {} }, c{ 2, 'c', {} }, d{ 1, 'd', {} };
+        for ( auto p : { &a, &b, &c, &d } )
+            items.push_back( *p );
+        {
+            Item e{ 0, 'e', {} };
+            items.push_front( e );
+            EXPECT_EQ( items.size(), 5 );
+        }
+        EXPECT_EQ( items.size(), 4 );
+
+        items.sort( []( const Item & x, const Item & y ){ return x.key < y.key; } );
+        std::string tags;
+        for ( const auto & i : items )
+            tags += i.tag;
+        EXPECT_EQ( tags, "bdac" );
+
+        auto same_key = []( const Item & x, const Item & y ){ return x.key == y.key; };
+        EXPECT_EQ( items.unique( same_key ), 2 );
+        EXPECT_EQ( items.front().tag, 'b' );
+        EXPECT_EQ( items.back().tag, 'a' );
+        EXPECT_FALSE( d.hook.is_linked() );
+
+        // A copy of a linked object starts out unlinked.
+        Item f{ a };
+        EXPECT_FALSE( f.hook.is_linked() );
+        items.pop_front();
+        items.pop_back();
+        EXPECT_TRUE( items.empty() );
+    }
+    {
+        BEGIN_TEST(tm5, "StaticList 1", "fixed capacity: try_push_back reports a full list, push_back throws.");
+        sc::static_list< int, 4 > list_a{ 1, 2, 3 };
+        EXPECT_TRUE( list_a.try_push_back( 4 ) );
+        EXPECT_TRUE( list_a.full() );
+        EXPECT_FALSE( list_a.try_push_back( 5 ) );
+        EXPECT_FALSE( list_a.try_push_front( 0 ) );
+
+        bool worked{ false };
+        try {
+            list_a.push_back( 5 );
+        } catch ( const std::length_error & ) {
+            worked = true;
+        }
+        EXPECT_TRUE( worked );
+        EXPECT_EQ( list_a.size(), 4 );
+
+        // Erased nodes go back to the free list and are used again.
+        list_a.erase( std::next( list_a.begin() ) );
+        list_a.pop_front();
+        EXPECT_TRUE( list_a.try_push_front( 7 ) );
+        list_a.insert( list_a.end(), 8 );
+        EXPECT_EQ( list_a, ( sc::static_list< int, 4 >{ 7, 3, 4, 8 } ) );
+
+        // A copy is independent of the original.
+        auto list_b = list_a;
+        list_b.reverse();
+        list_b.front() = 0;
+        EXPECT_EQ( list_b, ( sc::static_list< int, 4 >{ 0, 4, 3, 7 } ) );
+        EXPECT_EQ( list_a.back(), 8 );
+
+        sc::static_list< int, 4 > list_c{ 1, 2 };
+        worked = false;
+        try {
+            list_a.merge( list_c );
+        } catch ( const std::length_error & ) {
+            worked = true;
+        }
+        EXPECT_TRUE( worked );
+        EXPECT_EQ( list_c.size(), 2 );
+    }
+    {
+        BEGIN_TEST(tm5, "StaticList 2", "sort, merge, splice and unique agree with std::list.");
+        using Static = sc::static_list< std::pair< int, int >, 64 >;
+        auto by_key = []( const std::pair< int, int > & a, const std::pair< int, int > & b ){ return a.first < b.first; };
+        auto same_key = []( const std::pair< int, int > & a, const std::pair< int, int > & b ){ return a.first == b.first; };
+        std::mt19937 gen{ 47 };
+        std::uniform_int_distribution< int > key{ 0, 9 };
+
+        Static list_a, list_b;
+        std::list< std::pair< int, int > > ref_a, ref_b;
+        for ( int i{0} ; i < 30 ; ++i ) {
+            std::pair< int, int > v{ key( gen ), i };
+            ( i % 3 ? list_a : list_b ).push_back( v );
+            ( i % 3 ? ref_a : ref_b ).push_back( v );
+        }
+        list_a.sort( by_key );
+        ref_a.sort( by_key );
+        list_b.sort( by_key );
+        ref_b.sort( by_key );
+        list_a.merge( list_b, by_key );
+        ref_a.merge( ref_b, by_key );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_EQ( list_a.size(), ref_a.size() );
+        EXPECT_TRUE( std::equal( ref_a.begin(), ref_a.end(), list_a.begin() ) );
+
+        list_b.push_back( { 42, 0 } );
+        list_b.push_back( { 43, 0 } );
+        ref_b.push_back( { 42, 0 } );
+        ref_b.push_back( { 43, 0 } );
+        list_a.splice( std::next( list_a.begin(), 5 ), list_b );
+        ref_a.splice( std::next( ref_a.begin(), 5 ), ref_b );
+        list_a.splice( list_a.begin(), list_a, std::prev( list_a.end() ) );
+        ref_a.splice( ref_a.begin(), ref_a, std::prev( ref_a.end() ) );
+        list_a.unique( same_key );
+        ref_a.unique( same_key );
+        EXPECT_EQ( list_a.size(), ref_a.size() );
+        EXPECT_TRUE( std::equal( ref_a.begin(), ref_a.end(), list_a.begin() ) );
+    }
+#if __cplusplus >= 202002L
+    {
+        BEGIN_TEST(tm5, "StaticList 3", "builds a sorted table at compile time.");
+        constexpr auto table = []{
+            sc::static_list< int, 8 > l{ 5, 3, 8, 1, 3 };
+            l.sort();
+            l.unique();
+            l.push_front( 0 );
+            return l;
+        }();
+        static_assert( table.size() == 5 and table.front() == 0 and table.back() == 8, "built at compile time" );
+        EXPECT_EQ( table, ( sc::static_list< int, 8 >{ 0, 1, 3, 5, 8 } ) );
+    }
+#endif
+
+    std::cout << std::endl;
+    tm5.summary();
+
     return 0;
 }
     